@@ -34,4 +34,61 @@ UBYTE audioMixerIsPlaybackDone(UBYTE ubChannelIndex);
 
 void audioMixerSetVolume(UBYTE ubVolume);
 
+/**
+ * @brief Returns number of software channels of the mixer build in use.
+ */
+UBYTE audioMixerGetChannelCount(void);
+
+#if defined(MIXER_VARIANTS)
+/**
+ * @brief Picks the mixer build to be used by audioMixerCreate().
+ * Build 0 uses the main AUDIO_MIXER_* settings, the next ones follow
+ * AUDIO_MIXER_VARIANTS in their order. Must be called before
+ * audioMixerCreate() or after audioMixerDestroy().
+ *
+ * @param ubVariant Index of the build to use.
+ */
+void audioMixerSelectVariant(UBYTE ubVariant);
+#endif
+
+#if defined(MIXER_ENABLE_CALLBACK)
+/**
+ * @brief Callback for end of one-shot sound effect playback, called from
+ * within mixer's interrupt.
+ *
+ * @param ubChannel Mixer's software channel on which playback has ended.
+ * @param pData Data of sound effect which has ended.
+ * @return 1 if callback started next sound effect on the same channel,
+ * which makes it continue seamlessly, otherwise 0.
+ */
+typedef UBYTE (*tAudioMixerCbSfxEnd)(UBYTE ubChannel, const UWORD *pData);
+
+/**
+ * @brief Sets callback for sound effect playback end.
+ *
+ * @param cbSfxEnd Callback to be used, zero to disable it.
+ */
+void audioMixerSetSfxEndCallback(tAudioMixerCbSfxEnd cbSfxEnd);
+#endif
+
+#if defined(MIXER_COUNTER)
+/**
+ * @brief Mixer interrupt load gathered since last audioMixerProfileTake().
+ */
+typedef struct tAudioMixerProfile {
+	UWORD uwInterrupts; ///< Mixer interrupt runs, as counted by the mixer.
+	ULONG ulClocks; ///< Total time spent in mixer interrupt, in color clocks.
+	ULONG ulWorstClocks; ///< Longest single mixer interrupt, in color clocks.
+} tAudioMixerProfile;
+
+/**
+ * @brief Fetches mixer interrupt load & starts gathering it anew.
+ * Time is measured with beam position around the mixer's interrupt handler,
+ * so it also includes any higher level interrupts which have preempted it.
+ *
+ * @param pProfile Gathered load. Pass zero to only discard it.
+ */
+void audioMixerProfileTake(tAudioMixerProfile *pProfile);
+#endif
+
 #endif // ACE_MIXER_AUDIO_MIXER_H
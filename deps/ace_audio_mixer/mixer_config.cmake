@@ -15,6 +15,7 @@ set(AUDIO_MIXER_PROFILER OFF CACHE BOOL "Enable coloring during mixer runtime")
 set(AUDIO_MIXER_HW_CHANNELS "0;1;2;3" CACHE STRING "Hardware channels that have mixing enabled.")
 set(AUDIO_MIXER_SW_CHANNEL_COUNT "2" CACHE STRING "Number of software channels per audio channel (1-4).")
 set(AUDIO_MIXER_PERIOD "322" CACHE STRING "Playback period (124-).")
+set(AUDIO_MIXER_VARIANTS "" CACHE STRING "Postfixes of extra mixer builds selectable at runtime, configured with AUDIO_MIXER_VARIANT_<postfix>_68020 and AUDIO_MIXER_VARIANT_<postfix>_SW_CHANNEL_COUNT.")
 
 message(STATUS "[MIX] AUDIO_MIXER_HW_CHANNEL_MODE: '${AUDIO_MIXER_HW_CHANNEL_MODE}'")
 message(STATUS "[MIX] AUDIO_MIXER_HQ_MODE: '${AUDIO_MIXER_HQ_MODE}'")
@@ -31,6 +32,7 @@ message(STATUS "[MIX] AUDIO_MIXER_PROFILER: '${AUDIO_MIXER_PROFILER}'")
 message(STATUS "[MIX] AUDIO_MIXER_HW_CHANNELS: '${AUDIO_MIXER_HW_CHANNELS}'")
 message(STATUS "[MIX] AUDIO_MIXER_SW_CHANNEL_COUNT: '${AUDIO_MIXER_SW_CHANNEL_COUNT}'")
 message(STATUS "[MIX] AUDIO_MIXER_PERIOD: '${AUDIO_MIXER_PERIOD}'")
+message(STATUS "[MIX] AUDIO_MIXER_VARIANTS: '${AUDIO_MIXER_VARIANTS}'")
 
 # Convert CMake vars to config file vars
 set(CFG_MIXER_SINGLE 0)
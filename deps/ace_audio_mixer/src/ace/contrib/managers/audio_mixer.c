@@ -5,22 +5,63 @@
 #include <ace/contrib/managers/audio_mixer.h>
 #include <ace/managers/memory.h>
 #include <ace/managers/system.h>
+#include <ace/utils/custom.h>
 #include <hardware/intbits.h>
 #include <hardware/dmabits.h>
 #include "mixer_config.h"
 #include "mixer.h"
 
+#if defined(CFG_MIXER_COUNTER)
+#if defined(CFG_MIXER_NTSC)
+#define AUDIO_MIXER_LINES_PER_FRAME 263
+#else
+#define AUDIO_MIXER_LINES_PER_FRAME 313
+#endif
+#define AUDIO_MIXER_CLOCKS_PER_LINE 227
+#define AUDIO_MIXER_CLOCKS_PER_FRAME (\
+	AUDIO_MIXER_LINES_PER_FRAME * AUDIO_MIXER_CLOCKS_PER_LINE \
+)
+#endif
+
 typedef void (*tCbMixerIrqHandler)();
 
 static ULONG s_ulBufferSize;
 static void *s_pBuffer;
 static tCbMixerIrqHandler s_cbMixerIrqHandler;
+#if defined(CFG_MIXER_ENABLE_CALLBACK)
+static tAudioMixerCbSfxEnd s_cbSfxEnd;
+#endif
+#if defined(CFG_MIXER_COUNTER)
+static volatile ULONG s_ulProfileClocks;
+static volatile ULONG s_ulProfileWorstClocks;
+
+__attribute__((always_inline))
+static inline ULONG audioMixerGetBeamClock(void) {
+	// vposr & vhposr read at once, so that line & horizontal pos match
+	ULONG ulPos = *(volatile ULONG*)&g_pCustom->vposr;
+	return ((ulPos >> 8) & 0x1FF) * AUDIO_MIXER_CLOCKS_PER_LINE + (ulPos & 0xFF);
+}
+#endif
 
 static void onChannelInterrupt(
 	UNUSED_ARG REGARG(volatile tCustom *pCustom, "a0"),
 	UNUSED_ARG REGARG(volatile void *pData, "a1")
 ) {
+#if defined(CFG_MIXER_COUNTER)
+	ULONG ulStart = audioMixerGetBeamClock();
+	s_cbMixerIrqHandler();
+	LONG lElapsed = audioMixerGetBeamClock() - ulStart;
+	if(lElapsed < 0) {
+		// Crossed the frame boundary
+		lElapsed += AUDIO_MIXER_CLOCKS_PER_FRAME;
+	}
+	s_ulProfileClocks += lElapsed;
+	if((ULONG)lElapsed > s_ulProfileWorstClocks) {
+		s_ulProfileWorstClocks = lElapsed;
+	}
+#else
 	s_cbMixerIrqHandler();
+#endif
 }
 
 //---------------------------------------------------------------- ASM CALLBACKS
@@ -105,6 +146,18 @@ void mixerAcknowledgeIrq(void) {
 	// done by ACE's interrupt handler system
 }
 
+#if defined(CFG_MIXER_ENABLE_CALLBACK)
+static ULONG mixerOnSampleEnd(
+	REGARG(UWORD uwChannelId, "d0"), REGARG(void *pSample, "a0")
+) {
+	UBYTE ubChannel = 0;
+	for(UWORD uwMixerBits = (uwChannelId / MIX_CH0) & 0xF; uwMixerBits > 1; uwMixerBits >>= 1) {
+		++ubChannel;
+	}
+	return s_cbSfxEnd(ubChannel, pSample);
+}
+#endif
+
 __attribute__((used))
 void mixerSetDmaCon(void) {
 	register volatile ULONG reg_dmacon __asm("d0");
@@ -131,6 +184,9 @@ void audioMixerCreate(void) {
 	MixerSetIRQDMACallbacks(&s_sCallbacks);
 	MixerInstallHandler(0, 0);
 	MixerStart();
+#if defined(CFG_MIXER_COUNTER)
+	audioMixerProfileTake(0);
+#endif
 }
 
 void audioMixerDestroy(void) {
@@ -161,3 +217,42 @@ UBYTE audioMixerIsPlaybackDone(UBYTE ubChannelIndex) {
 void audioMixerSetVolume(UBYTE ubVolume) {
 	MixerVolume(ubVolume);
 }
+
+UBYTE audioMixerGetChannelCount(void) {
+	return MixerGetTotalChannelCount();
+}
+
+#if defined(MIXER_VARIANTS)
+void audioMixerSelectVariant(UBYTE ubVariant) {
+	MixerSelectVariant(ubVariant);
+}
+#endif
+
+#if defined(CFG_MIXER_ENABLE_CALLBACK)
+void audioMixerSetSfxEndCallback(tAudioMixerCbSfxEnd cbSfxEnd) {
+	if(cbSfxEnd) {
+		s_cbSfxEnd = cbSfxEnd;
+		MixerEnableCallback((ULONG (*)())mixerOnSampleEnd);
+	}
+	else {
+		MixerDisableCallback();
+		s_cbSfxEnd = 0;
+	}
+}
+#endif
+
+#if defined(CFG_MIXER_COUNTER)
+void audioMixerProfileTake(tAudioMixerProfile *pProfile) {
+	// Don't let the mixer interrupt run between read & reset
+	g_pCustom->intena = INTF_INTEN;
+	if(pProfile) {
+		pProfile->uwInterrupts = MixerGetCounter();
+		pProfile->ulClocks = s_ulProfileClocks;
+		pProfile->ulWorstClocks = s_ulProfileWorstClocks;
+	}
+	MixerResetCounter();
+	s_ulProfileClocks = 0;
+	s_ulProfileWorstClocks = 0;
+	g_pCustom->intena = INTF_SETCLR | INTF_INTEN;
+}
+#endif
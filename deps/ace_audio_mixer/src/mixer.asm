@@ -4166,13 +4166,13 @@ _MixerGetChannelStatus\1		EQU	MixerGetChannelStatus\1
 _MixerEnableCallback\1			EQU MixerEnableCallback\1
 _MixerDisableCallback\1			EQU	MixerDisableCallback\1
 _MixerGetPluginsBufferSize\1	EQU MixerGetPluginsBufferSize\1
-_MixerGetTotalChannelCount\1	EQU MixerGetTotalChannelCount
-_MixerSetPluginDeferredPtr\1	EQU MixerSetPluginDeferredPtr
-_MixerGetChannelBufferSize\1	EQU MixerGetChannelBufferSize
-_MixerResetCounter\1			EQU	MixerResetCounter
-_MixerGetCounter\1				EQU	MixerGetCounter
-_MixerSetReturnVector\1			EQU MixerSetReturnVector
-_MixerSetIRQDMACallbacks\1		EQU	MixerSetIRQDMACallbacks
+_MixerGetTotalChannelCount\1	EQU MixerGetTotalChannelCount\1
+_MixerSetPluginDeferredPtr\1	EQU MixerSetPluginDeferredPtr\1
+_MixerGetChannelBufferSize\1	EQU MixerGetChannelBufferSize\1
+_MixerResetCounter\1			EQU	MixerResetCounter\1
+_MixerGetCounter\1				EQU	MixerGetCounter\1
+_MixerSetReturnVector\1			EQU MixerSetReturnVector\1
+_MixerSetIRQDMACallbacks\1		EQU	MixerSetIRQDMACallbacks\1
 
 
 	XDEF	_MixerGetBufferSize\1
@@ -416,6 +416,37 @@ void MixerDisableCallback(void)
 */
 MIX_API void MixerDisableCallback(void);
 
+/*
+void MixerResetCounter(void)
+	This function sets the mixer interrupt counter to 0.
+
+	Note: this function is only available if MIXER_COUNTER is set to 1
+	      in mixer_config.i
+*/
+MIX_API void MixerResetCounter(void);
+
+/*
+UWORD MixerGetCounter(void)
+	This function returns the current value of the mixer interrupt counter,
+	which is increased by one each time the mixer interrupt handler has run.
+
+	Note: this function is only available if MIXER_COUNTER is set to 1
+	      in mixer_config.i
+*/
+MIX_API UWORD MixerGetCounter(void);
+
+/*
+void MixerSelectVariant(UBYTE variant)
+	This function picks which of the mixer builds is used by all subsequent
+	calls. Build 0 uses the main mixer_config.i settings, the next ones follow
+	AUDIO_MIXER_VARIANTS in their order.
+
+	Note: this function must be called before MixerSetup() or after
+	      MixerRemoveHandler().
+	Note: this function is only available if AUDIO_MIXER_VARIANTS is set.
+*/
+MIX_API void MixerSelectVariant(MIX_REGARG(UBYTE variant,"d0"));
+
 /*
 void MixerSetPluginDeferredPtr(void *deferred_function_ptr, void *mxchannel_ptr)
 	This routine is called by a plugin whenever it needs to do a deferred 
@@ -804,6 +835,51 @@ MIX_API void MixerDisableCallback(void)
 	);
 }
 
+MIX_API void MixerResetCounter(void)
+{
+	__asm__ volatile (
+		"jsr _MixerResetCounter"
+		// OutputOperands
+		:
+		// InputOperands
+		:
+		// Clobbers
+		: "cc"
+	);
+}
+
+MIX_API UWORD MixerGetCounter(void)
+{
+	register volatile UWORD reg_result __asm("d0");
+
+	__asm__ volatile (
+		"jsr _MixerGetCounter"
+		// OutputOperands
+		: "=r" (reg_result)
+		// InputOperands
+		:
+		// Clobbers
+		: "cc"
+	);
+
+	return reg_result;
+}
+
+MIX_API void MixerSelectVariant(UBYTE variant)
+{
+	register volatile UBYTE reg_variant __asm("d0") = variant;
+
+	__asm__ volatile (
+		"jsr _MixerSelectVariant"
+		// OutputOperands
+		:
+		// InputOperands
+		: "r" (reg_variant)
+		// Clobbers
+		: "cc"
+	);
+}
+
 MIX_API void MixerSetPluginDeferredPtr(void (*deferred_function_ptr)(),
 									   void *mxchannel_ptr)
 {
@@ -0,0 +1,527 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "asset_archive.h"
+#include <string.h>
+#include <ace/macros.h>
+#include <ace/managers/log.h>
+#include <ace/managers/memory.h>
+#include <ace/managers/system.h>
+#include <ace/managers/timer.h>
+#include <ace/utils/disk_file.h>
+#include <ace/utils/string.h>
+#include "asset_lz.h"
+
+#define ASSET_ARCHIVE_VERSION 2
+#define ASSET_ARCHIVE_NAME_SIZE 30
+#define ASSET_ARCHIVE_ENTRIES_MAX 255 ///< Same as tools/asset_pack's limit.
+#define ASSET_ARCHIVE_MEM_CHIP 0
+#define ASSET_ARCHIVE_MEM_FAST 1
+#define ASSET_ARCHIVE_FLAG_LZ 1
+#define ASSET_ARCHIVE_DISK_PATH_SIZE 40
+#define ASSET_ARCHIVE_SKIP_SIZE 64
+// Range of sizes read per prefetch call, adjusted to fit in the time budget
+#define ASSET_ARCHIVE_PREFETCH_CHUNK_MIN 512
+#define ASSET_ARCHIVE_PREFETCH_CHUNK_MAX 8192
+// Time per frame which may be spent on prefetch, in timerGetPrec() ticks,
+// which run at PAL CIA clock of ~709 kHz. That's ~8 ms of 20 ms frame.
+#define ASSET_ARCHIVE_PREFETCH_BUDGET (8 * 709)
+
+// Same layout as written by tools/asset_pack, offsets are from archive start.
+typedef struct tAssetArchiveEntry {
+	char szName[ASSET_ARCHIVE_NAME_SIZE];
+	UBYTE ubMemType;
+	UBYTE ubFlags;
+	ULONG ulOffset;
+	ULONG ulSize; ///< Size after decompression.
+	ULONG ulPackedSize; ///< Size as stored in archive.
+} tAssetArchiveEntry;
+
+typedef struct tAssetArchiveHeader {
+	UBYTE ubVersion;
+	UBYTE ubReserved;
+	UWORD uwEntryCount;
+} tAssetArchiveHeader;
+
+typedef struct tAssetArchiveFile {
+	const tAssetArchiveEntry *pEntry;
+	ULONG ulPos; ///< Position in decompressed contents.
+	ULONG ulPackedPos; ///< Position in stored data, same as ulPos if raw.
+	tAssetLz *pLz; ///< Decompressor state, zero for raw entries.
+#if defined(GAME_DEBUG)
+	ULONG ulReadTime;
+	ULONG ulDiskTime; ///< Part of read time spent reading stored data.
+#endif
+} tAssetArchiveFile;
+
+static tFile *s_pArchive;
+static ULONG s_ulArchivePos; ///< Position of archive's file handle.
+static tAssetArchiveEntry *s_pEntries;
+static UWORD s_uwEntryCount;
+static UWORD s_uwSeekCount;
+static ULONG s_ulArchiveSize;
+
+// Ring buffer of archive's data read ahead of the loaders.
+static UBYTE *s_pPrefetch;
+static ULONG s_ulPrefetchPos; ///< Archive position of the oldest byte in ring.
+static ULONG s_ulPrefetchHead; ///< Ring index of the oldest byte.
+static ULONG s_ulPrefetchFill;
+static ULONG s_ulPrefetchHits;
+static UWORD s_uwPrefetchChunk; ///< Current read size, from measured time.
+static UWORD s_uwPrefetchCooldown; ///< Calls to skip after a too long read.
+static UWORD s_uwPrefetchOverruns;
+static ULONG s_ulPrefetchWorstTime; ///< Longest read, i.e. worst frame hitch.
+
+#if defined(GAME_DEBUG)
+// Totals of all loads from archive, so that whole load time may be compared
+// between builds with & without GAME_ASSETS_LZ.
+static ULONG s_ulLoadTime;
+static ULONG s_ulLoadDiskTime;
+static ULONG s_ulLoadBytes;
+static ULONG s_ulLoadStoredBytes;
+#endif
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static void assetArchiveFileClose(void *pData) {
+	tAssetArchiveFile *pFile = pData;
+#if defined(GAME_DEBUG)
+	char szTime[15];
+	char szDiskTime[15];
+	timerFormatPrec(szTime, pFile->ulReadTime);
+	timerFormatPrec(szDiskTime, pFile->ulDiskTime);
+	logWrite(
+		"Read '%s': %lu of %lu bytes, %lu stored, in %s (disk %s)\n",
+		pFile->pEntry->szName, pFile->ulPos, pFile->pEntry->ulSize,
+		pFile->ulPackedPos, szTime, szDiskTime
+	);
+	s_ulLoadTime += pFile->ulReadTime;
+	s_ulLoadDiskTime += pFile->ulDiskTime;
+	s_ulLoadBytes += pFile->ulPos;
+	s_ulLoadStoredBytes += pFile->ulPackedPos;
+#endif
+	if(pFile->pLz) {
+		memFree(pFile->pLz, sizeof(*pFile->pLz));
+	}
+	memFree(pFile, sizeof(*pFile));
+}
+
+// Removes oldest bytes from prefetch ring, copying them if pDest is set.
+static void assetArchivePrefetchTake(UBYTE *pDest, ULONG ulSize) {
+	while(ulSize) {
+		ULONG ulCount = GAME_PREFETCH_SIZE - s_ulPrefetchHead;
+		if(ulCount > ulSize) {
+			ulCount = ulSize;
+		}
+		if(pDest) {
+			memcpy(pDest, &s_pPrefetch[s_ulPrefetchHead], ulCount);
+			pDest += ulCount;
+		}
+		s_ulPrefetchHead += ulCount;
+		if(s_ulPrefetchHead == GAME_PREFETCH_SIZE) {
+			s_ulPrefetchHead = 0;
+		}
+		s_ulPrefetchPos += ulCount;
+		s_ulPrefetchFill -= ulCount;
+		ulSize -= ulCount;
+	}
+}
+
+static ULONG assetArchiveReadAt(ULONG ulArchivePos, UBYTE *pDest, ULONG ulSize) {
+	ULONG ulDone = 0;
+	if(s_pPrefetch && ulArchivePos >= s_ulPrefetchPos) {
+		// Loaders read in archive's order, so anything before requested
+		// position won't be needed anymore
+		ULONG ulSkip = ulArchivePos - s_ulPrefetchPos;
+		if(ulSkip > s_ulPrefetchFill) {
+			ulSkip = s_ulPrefetchFill;
+		}
+		assetArchivePrefetchTake(0, ulSkip);
+		if(ulArchivePos == s_ulPrefetchPos) {
+			ulDone = (ulSize < s_ulPrefetchFill) ? ulSize : s_ulPrefetchFill;
+			assetArchivePrefetchTake(pDest, ulDone);
+			s_ulPrefetchHits += ulDone;
+		}
+	}
+
+	if(ulDone < ulSize) {
+		ulArchivePos += ulDone;
+		if(ulArchivePos != s_ulArchivePos) {
+			fileSeek(s_pArchive, ulArchivePos, FILE_SEEK_SET);
+			++s_uwSeekCount;
+		}
+		ULONG ulRead = fileRead(s_pArchive, &pDest[ulDone], ulSize - ulDone);
+		s_ulArchivePos = ulArchivePos + ulRead;
+		ulDone += ulRead;
+		if(s_pPrefetch && !s_ulPrefetchFill && s_ulArchivePos > s_ulPrefetchPos) {
+			// Loader got ahead of prefetch, continue after it
+			s_ulPrefetchPos = s_ulArchivePos;
+		}
+	}
+	return ulDone;
+}
+
+// Reads stored data of the entry, compressed or not.
+static ULONG assetArchiveFileReadPacked(void *pData, UBYTE *pDest, ULONG ulSize) {
+	tAssetArchiveFile *pFile = pData;
+	ULONG ulLeft = pFile->pEntry->ulPackedSize - pFile->ulPackedPos;
+	if(ulSize > ulLeft) {
+		ulSize = ulLeft;
+	}
+
+#if defined(GAME_DEBUG)
+	ULONG ulStart = timerGetPrec();
+#endif
+	ULONG ulRead = assetArchiveReadAt(
+		pFile->pEntry->ulOffset + pFile->ulPackedPos, pDest, ulSize
+	);
+	pFile->ulPackedPos += ulRead;
+#if defined(GAME_DEBUG)
+	pFile->ulDiskTime += timerGetDelta(ulStart, timerGetPrec());
+#endif
+	return ulRead;
+}
+
+static ULONG assetArchiveFileRead(void *pData, void *pDest, ULONG ulSize) {
+	tAssetArchiveFile *pFile = pData;
+#if defined(GAME_DEBUG)
+	ULONG ulStart = timerGetPrec();
+#endif
+	ULONG ulRead;
+	if(pFile->pLz) {
+		ulRead = assetLzRead(pFile->pLz, pDest, ulSize);
+	}
+	else {
+		ulRead = assetArchiveFileReadPacked(pFile, pDest, ulSize);
+	}
+	pFile->ulPos += ulRead;
+#if defined(GAME_DEBUG)
+	pFile->ulReadTime += timerGetDelta(ulStart, timerGetPrec());
+#endif
+	return ulRead;
+}
+
+static ULONG assetArchiveFileWrite(
+	UNUSED_ARG void *pData, UNUSED_ARG const void *pSrc, UNUSED_ARG ULONG ulSize
+) {
+	return 0;
+}
+
+static ULONG assetArchiveFileSeek(void *pData, LONG lPos, WORD wMode) {
+	tAssetArchiveFile *pFile = pData;
+	if(wMode == FILE_SEEK_CURRENT) {
+		lPos += pFile->ulPos;
+	}
+	else if(wMode == FILE_SEEK_END) {
+		lPos += pFile->pEntry->ulSize;
+	}
+	if(lPos < 0 || (ULONG)lPos > pFile->pEntry->ulSize) {
+		return 0;
+	}
+	if(!pFile->pLz) {
+		// Archive's handle is moved on next read, if needed at all
+		pFile->ulPos = lPos;
+		pFile->ulPackedPos = lPos;
+		return 1;
+	}
+
+	// Compressed stream can only be skipped forward by decompressing it
+	if((ULONG)lPos < pFile->ulPos) {
+		logWrite(
+			"ERR: Can't seek back in compressed '%s'\n", pFile->pEntry->szName
+		);
+		return 0;
+	}
+	UBYTE pSkipped[ASSET_ARCHIVE_SKIP_SIZE];
+	while(pFile->ulPos < (ULONG)lPos) {
+		ULONG ulSkip = lPos - pFile->ulPos;
+		if(ulSkip > sizeof(pSkipped)) {
+			ulSkip = sizeof(pSkipped);
+		}
+		if(!assetArchiveFileRead(pFile, pSkipped, ulSkip)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static ULONG assetArchiveFileGetPos(void *pData) {
+	const tAssetArchiveFile *pFile = pData;
+	return pFile->ulPos;
+}
+
+static UBYTE assetArchiveFileIsEof(void *pData) {
+	const tAssetArchiveFile *pFile = pData;
+	return pFile->ulPos >= pFile->pEntry->ulSize;
+}
+
+static void assetArchiveFileFlush(UNUSED_ARG void *pData) {
+}
+
+static const tFileCallbacks s_sArchiveFileCallbacks = {
+	.cbFileClose = assetArchiveFileClose,
+	.cbFileRead = assetArchiveFileRead,
+	.cbFileWrite = assetArchiveFileWrite,
+	.cbFileSeek = assetArchiveFileSeek,
+	.cbFileGetPos = assetArchiveFileGetPos,
+	.cbFileIsEof = assetArchiveFileIsEof,
+	.cbFileFlush = assetArchiveFileFlush,
+};
+
+static const tAssetArchiveEntry *assetArchiveFind(const char *szName) {
+	for(UWORD i = 0; i < s_uwEntryCount; ++i) {
+		if(!strcmp(s_pEntries[i].szName, szName)) {
+			return &s_pEntries[i];
+		}
+	}
+	return 0;
+}
+
+static void assetArchiveGetDiskPath(const char *szName, char *szPath) {
+	stringCopy(szName, stringCopy("data/", szPath));
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void assetArchiveCreate(const char *szPath) {
+	logBlockBegin("assetArchiveCreate(szPath: '%s')", szPath);
+	s_uwEntryCount = 0;
+	s_uwSeekCount = 0;
+	s_pEntries = 0;
+	s_pArchive = diskFileOpen(szPath, DISK_FILE_MODE_READ, 1);
+	if(!s_pArchive) {
+		logWrite("ERR: Can't open archive, using separate files\n");
+		logBlockEnd("assetArchiveCreate()");
+		return;
+	}
+
+	// Truncated or foreign archive falls back to separate files
+	tAssetArchiveHeader sHeader;
+	ULONG ulEntriesSize = 0;
+	if(fileRead(s_pArchive, &sHeader, sizeof(sHeader)) != sizeof(sHeader)) {
+		logWrite("ERR: Can't read archive header\n");
+	}
+	else if(sHeader.ubVersion != ASSET_ARCHIVE_VERSION) {
+		logWrite("ERR: Unsupported archive version: %hhu\n", sHeader.ubVersion);
+	}
+	else if(
+		!sHeader.uwEntryCount || sHeader.uwEntryCount > ASSET_ARCHIVE_ENTRIES_MAX
+	) {
+		logWrite("ERR: Bad archive entry count: %hu\n", sHeader.uwEntryCount);
+	}
+	else {
+		ulEntriesSize = sHeader.uwEntryCount * sizeof(tAssetArchiveEntry);
+		s_pEntries = memAllocFast(ulEntriesSize);
+		if(!s_pEntries) {
+			logWrite("ERR: No memory for archive entries\n");
+		}
+		else if(fileRead(s_pArchive, s_pEntries, ulEntriesSize) != ulEntriesSize) {
+			logWrite("ERR: Can't read archive entries\n");
+			memFree(s_pEntries, ulEntriesSize);
+			s_pEntries = 0;
+		}
+	}
+	if(!s_pEntries) {
+		logWrite("Using separate files\n");
+		fileClose(s_pArchive);
+		s_pArchive = 0;
+		logBlockEnd("assetArchiveCreate()");
+		return;
+	}
+
+	s_uwEntryCount = sHeader.uwEntryCount;
+	s_ulArchivePos = sizeof(sHeader) + ulEntriesSize;
+	s_ulArchiveSize = s_ulArchivePos;
+	for(UWORD i = 0; i < s_uwEntryCount; ++i) {
+		ULONG ulEnd = s_pEntries[i].ulOffset + s_pEntries[i].ulPackedSize;
+		if(ulEnd > s_ulArchiveSize) {
+			s_ulArchiveSize = ulEnd;
+		}
+	}
+	s_pPrefetch = 0;
+#if defined(GAME_DEBUG)
+	s_ulLoadTime = 0;
+	s_ulLoadDiskTime = 0;
+	s_ulLoadBytes = 0;
+	s_ulLoadStoredBytes = 0;
+#endif
+	logWrite("Entries: %hu\n", s_uwEntryCount);
+	logBlockEnd("assetArchiveCreate()");
+}
+
+void assetArchiveDestroy(void) {
+	logBlockBegin("assetArchiveDestroy()");
+	assetArchivePrefetchEnd();
+	if(s_pArchive) {
+		logWrite("Seeks done: %hu\n", s_uwSeekCount);
+#if defined(GAME_DEBUG)
+		// Time left after disk reads is spent on decompression & copying
+		char szTime[15];
+		char szDiskTime[15];
+		timerFormatPrec(szTime, s_ulLoadTime);
+		timerFormatPrec(szDiskTime, s_ulLoadDiskTime);
+		logWrite(
+			"Loaded %lu bytes, %lu stored, in %s (disk %s)\n",
+			s_ulLoadBytes, s_ulLoadStoredBytes, szTime, szDiskTime
+		);
+#endif
+		memFree(s_pEntries, s_uwEntryCount * sizeof(tAssetArchiveEntry));
+		fileClose(s_pArchive);
+		s_pArchive = 0;
+	}
+	s_uwEntryCount = 0;
+	logBlockEnd("assetArchiveDestroy()");
+}
+
+void assetArchivePrefetchStart(void) {
+	if(!s_pArchive || s_pPrefetch || !GAME_PREFETCH_SIZE) {
+		return;
+	}
+	logBlockBegin("assetArchivePrefetchStart()");
+	s_pPrefetch = memAllocFast(GAME_PREFETCH_SIZE);
+	if(!s_pPrefetch) {
+		logWrite("ERR: No memory for prefetch\n");
+		logBlockEnd("assetArchivePrefetchStart()");
+		return;
+	}
+	s_ulPrefetchPos = s_ulArchivePos;
+	s_ulPrefetchHead = 0;
+	s_ulPrefetchFill = 0;
+	s_ulPrefetchHits = 0;
+	s_uwPrefetchChunk = ASSET_ARCHIVE_PREFETCH_CHUNK_MIN;
+	s_uwPrefetchCooldown = 0;
+	s_uwPrefetchOverruns = 0;
+	s_ulPrefetchWorstTime = 0;
+	logWrite("From archive pos %lu\n", s_ulPrefetchPos);
+	logBlockEnd("assetArchivePrefetchStart()");
+}
+
+void assetArchivePrefetchProcess(void) {
+	if(!s_pPrefetch) {
+		return;
+	}
+	if(s_uwPrefetchCooldown) {
+		--s_uwPrefetchCooldown;
+		return;
+	}
+	ULONG ulEnd = s_ulPrefetchPos + s_ulPrefetchFill;
+	ULONG ulTail = s_ulPrefetchHead + s_ulPrefetchFill;
+	if(ulTail >= GAME_PREFETCH_SIZE) {
+		ulTail -= GAME_PREFETCH_SIZE;
+	}
+	// Up to the ring's end, the rest goes on next call
+	ULONG ulCount = GAME_PREFETCH_SIZE - s_ulPrefetchFill;
+	if(ulCount > GAME_PREFETCH_SIZE - ulTail) {
+		ulCount = GAME_PREFETCH_SIZE - ulTail;
+	}
+	if(ulCount > s_ulArchiveSize - ulEnd) {
+		ulCount = s_ulArchiveSize - ulEnd;
+	}
+	if(ulCount > s_uwPrefetchChunk) {
+		ulCount = s_uwPrefetchChunk;
+	}
+	if(!ulCount) {
+		return;
+	}
+
+	// Reads are blocking, so their time is measured instead. OS is only
+	// running within systemUse(), so async DOS packets wouldn't progress
+	// between the calls anyway. Whether the chunk is already in trackdisk's
+	// track buffer isn't visible from DOS, so a read which misses it stalls
+	// the frame for a seek & whole track read - up to ~2 disk rotations,
+	// i.e. ~400 ms on DD floppy, more if chunk spans tracks. Chunk shrinking
+	// & cooldown below keep such reads rare, worst one is logged at the end.
+	ULONG ulStart = timerGetPrec();
+	systemUse();
+	if(ulEnd != s_ulArchivePos) {
+		fileSeek(s_pArchive, ulEnd, FILE_SEEK_SET);
+		++s_uwSeekCount;
+	}
+	ULONG ulRead = fileRead(s_pArchive, &s_pPrefetch[ulTail], ulCount);
+	systemUnuse();
+	ULONG ulTime = timerGetDelta(ulStart, timerGetPrec());
+	s_ulPrefetchWorstTime = MAX(s_ulPrefetchWorstTime, ulTime);
+	s_ulArchivePos = ulEnd + ulRead;
+	s_ulPrefetchFill += ulRead;
+
+	if(ulTime > ASSET_ARCHIVE_PREFETCH_BUDGET) {
+		// Probably missed the track buffer - read less & skip enough calls
+		// to keep the average within budget
+		s_uwPrefetchChunk = MAX(s_uwPrefetchChunk / 2, ASSET_ARCHIVE_PREFETCH_CHUNK_MIN);
+		s_uwPrefetchCooldown = MIN(ulTime / ASSET_ARCHIVE_PREFETCH_BUDGET, 0xFFFF);
+		++s_uwPrefetchOverruns;
+	}
+	else if(
+		ulTime < ASSET_ARCHIVE_PREFETCH_BUDGET / 2 &&
+		ulRead == s_uwPrefetchChunk
+	) {
+		s_uwPrefetchChunk = MIN(s_uwPrefetchChunk * 2, ASSET_ARCHIVE_PREFETCH_CHUNK_MAX);
+	}
+}
+
+void assetArchivePrefetchEnd(void) {
+	if(!s_pPrefetch) {
+		return;
+	}
+	char szWorstTime[15];
+	timerFormatPrec(szWorstTime, s_ulPrefetchWorstTime);
+	logWrite(
+		"Prefetch end: %lu bytes used, %lu unused, %hu reads over budget, worst read %s\n",
+		s_ulPrefetchHits, s_ulPrefetchFill, s_uwPrefetchOverruns, szWorstTime
+	);
+	memFree(s_pPrefetch, GAME_PREFETCH_SIZE);
+	s_pPrefetch = 0;
+}
+
+tFile *assetArchiveOpen(const char *szName, UBYTE *pIsFast) {
+	const tAssetArchiveEntry *pEntry = assetArchiveFind(szName);
+	if(!pEntry) {
+		if(pIsFast) {
+			*pIsFast = 0;
+		}
+		char szPath[ASSET_ARCHIVE_DISK_PATH_SIZE];
+		assetArchiveGetDiskPath(szName, szPath);
+		return diskFileOpen(szPath, DISK_FILE_MODE_READ, 1);
+	}
+
+	if(pIsFast) {
+		*pIsFast = (pEntry->ubMemType == ASSET_ARCHIVE_MEM_FAST);
+	}
+	tAssetArchiveFile *pData = memAllocFast(sizeof(*pData));
+	pData->pEntry = pEntry;
+	pData->ulPos = 0;
+	pData->ulPackedPos = 0;
+	pData->pLz = 0;
+#if defined(GAME_DEBUG)
+	pData->ulReadTime = 0;
+	pData->ulDiskTime = 0;
+#endif
+	if(pEntry->ubFlags & ASSET_ARCHIVE_FLAG_LZ) {
+		// Window is read back for each match, so it's kept out of chip RAM
+		pData->pLz = memAllocFast(sizeof(*pData->pLz));
+		assetLzInit(
+			pData->pLz, pEntry->ulSize, assetArchiveFileReadPacked, pData
+		);
+	}
+	// Freed by fileClose(), along with pData through cbFileClose
+	tFile *pFile = memAllocFast(sizeof(*pFile));
+	pFile->pCallbacks = &s_sArchiveFileCallbacks;
+	pFile->pData = pData;
+	return pFile;
+}
+
+UBYTE assetArchiveExists(const char *szName) {
+	if(assetArchiveFind(szName)) {
+		return 1;
+	}
+	char szPath[ASSET_ARCHIVE_DISK_PATH_SIZE];
+	assetArchiveGetDiskPath(szName, szPath);
+	return diskFileExists(szPath);
+}
+
+tBitMap *assetArchiveBitmapCreate(const char *szName) {
+	UBYTE isFast;
+	tFile *pFile = assetArchiveOpen(szName, &isFast);
+	return bitmapCreateFromFd(pFile, isFast);
+}
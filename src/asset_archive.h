@@ -0,0 +1,76 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_ASSET_ARCHIVE_H
+#define SURVIVOR_ASSET_ARCHIVE_H
+
+#include <ace/utils/bitmap.h>
+#include <ace/utils/file.h>
+
+/**
+ * @brief Opens asset archive made by tools/asset_pack & reads its manifest.
+ * Archive stays open until assetArchiveDestroy(), so that its files are read
+ * without any further directory lookups. If it's missing, all files are
+ * opened from disk instead.
+ *
+ * @param szPath Path to the archive.
+ */
+void assetArchiveCreate(const char *szPath);
+
+void assetArchiveDestroy(void);
+
+/**
+ * @brief Starts reading archive ahead of the loaders, from the position where
+ * the last load has ended, i.e. assets of the next gamestates in archive's
+ * order. Read data is kept in GAME_PREFETCH_SIZE bytes of fast RAM and
+ * handed over to files opened later, so that their load doesn't wait for
+ * the disk. Loading data which wasn't prefetched yet simply reads it from
+ * disk, so skipping ahead only makes the wait longer.
+ */
+void assetArchivePrefetchStart(void);
+
+/**
+ * @brief Reads next chunk ahead, if there's room for it. Meant to be
+ * called once per frame by gamestates with spare CPU time.
+ *
+ * The read is blocking, so its size follows the measured read time to stay
+ * within the per-frame budget. After a read which took longer, following
+ * calls are skipped for as many frames as it overran.
+ */
+void assetArchivePrefetchProcess(void);
+
+/**
+ * @brief Stops reading ahead & frees prefetched data which wasn't used.
+ */
+void assetArchivePrefetchEnd(void);
+
+/**
+ * @brief Opens file for reading, from the archive if it's packed there,
+ * otherwise from data directory. Archived files read in archive's order
+ * continue reading where the previous one ended, so no seeks are needed.
+ * Compressed files are decompressed while being read, they can only be
+ * seeked forward.
+ *
+ * @param szName File path relative to data directory.
+ * @param pIsFast If not zero, set to 1 if manifest says the file's contents
+ * belong to fast RAM, otherwise 0.
+ * @return File to be closed with fileClose(), zero on failure.
+ */
+tFile *assetArchiveOpen(const char *szName, UBYTE *pIsFast);
+
+/**
+ * @brief Checks if file is in the archive or in data directory.
+ *
+ * @param szName File path relative to data directory.
+ */
+UBYTE assetArchiveExists(const char *szName);
+
+/**
+ * @brief Loads bitmap from archive into memory given by the manifest.
+ *
+ * @param szName File path relative to data directory.
+ */
+tBitMap *assetArchiveBitmapCreate(const char *szName);
+
+#endif // SURVIVOR_ASSET_ARCHIVE_H
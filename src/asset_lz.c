@@ -0,0 +1,190 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "asset_lz.h"
+#include <stdint.h>
+
+#define ASSET_LZ_WINDOW_MASK (ASSET_LZ_WINDOW_SIZE - 1)
+
+// Byte buffers are copied through it, so it may alias them. Even address
+// is enough for 68000's longword access, same goes for the packer's build.
+typedef ULONG __attribute__((__may_alias__, __aligned__(2))) tAssetLzLong;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+// Copies in longwords if both pointers can be made even at once, since 68000
+// can't access words at odd addresses. Byte by byte otherwise. Reads go ahead
+// of writes, so destination may be below overlapping source.
+static void assetLzCopy(UBYTE *pDst, const UBYTE *pSrc, ULONG ulCount) {
+	if(!(((uintptr_t)pDst ^ (uintptr_t)pSrc) & 1)) {
+		if(((uintptr_t)pDst & 1) && ulCount) {
+			*(pDst++) = *(pSrc++);
+			--ulCount;
+		}
+		tAssetLzLong *pDstLong = (tAssetLzLong*)pDst;
+		const tAssetLzLong *pSrcLong = (const tAssetLzLong*)pSrc;
+		for(ULONG ulLongs = ulCount >> 2; ulLongs; --ulLongs) {
+			*(pDstLong++) = *(pSrcLong++);
+		}
+		pDst = (UBYTE*)pDstLong;
+		pSrc = (const UBYTE*)pSrcLong;
+		ulCount &= 3;
+	}
+	while(ulCount) {
+		*(pDst++) = *(pSrc++);
+		--ulCount;
+	}
+}
+
+// Limits copy so that it won't go past the window's end.
+static inline ULONG assetLzWindowRun(ULONG ulCount, UWORD uwPos) {
+	ULONG ulToEnd = ASSET_LZ_WINDOW_SIZE - uwPos;
+	return ulCount < ulToEnd ? ulCount : ulToEnd;
+}
+
+static UBYTE assetLzRefill(tAssetLz *pLz) {
+	if(pLz->uwInPos != pLz->uwInSize) {
+		return 1;
+	}
+	pLz->uwInSize = pLz->cbRead(pLz->pReadData, pLz->pIn, ASSET_LZ_IN_SIZE);
+	pLz->uwInPos = 0;
+	return pLz->uwInSize != 0;
+}
+
+static UBYTE assetLzFetch(tAssetLz *pLz, UBYTE *pByte) {
+	if(!assetLzRefill(pLz)) {
+		return 0;
+	}
+	*pByte = pLz->pIn[pLz->uwInPos++];
+	return 1;
+}
+
+static UBYTE assetLzFetchLength(tAssetLz *pLz, ULONG *pLength) {
+	UBYTE ubByte;
+	do {
+		if(!assetLzFetch(pLz, &ubByte)) {
+			return 0;
+		}
+		*pLength += ubByte;
+	} while(ubByte == ASSET_LZ_EXTENSION_MAX);
+	return 1;
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void assetLzInit(
+	tAssetLz *pLz, ULONG ulSize, tAssetLzCbRead cbRead, void *pReadData
+) {
+	pLz->cbRead = cbRead;
+	pLz->pReadData = pReadData;
+	pLz->ulOutLeft = ulSize;
+	pLz->ulLiteralsLeft = 0;
+	pLz->ulMatchLeft = 0;
+	pLz->uwMatchDistance = 0;
+	pLz->uwWindowPos = 0;
+	pLz->uwInPos = 0;
+	pLz->uwInSize = 0;
+	pLz->ubMatchNibble = 0;
+	pLz->isMatchPending = 0;
+}
+
+ULONG assetLzRead(tAssetLz *pLz, UBYTE *pDest, ULONG ulSize) {
+	if(ulSize > pLz->ulOutLeft) {
+		ulSize = pLz->ulOutLeft;
+	}
+
+	// Window position is kept in register during copy loops. Copies are split
+	// at window's end, so that each part is a straight longword copy.
+	UBYTE *pWindow = pLz->pWindow;
+	UWORD uwWindowPos = pLz->uwWindowPos;
+	ULONG ulLeft = ulSize;
+	UBYTE isOk = 1;
+	while(ulLeft && isOk) {
+		if(pLz->ulLiteralsLeft) {
+			if(!assetLzRefill(pLz)) {
+				isOk = 0;
+				break;
+			}
+			ULONG ulCount = pLz->uwInSize - pLz->uwInPos;
+			if(ulCount > pLz->ulLiteralsLeft) {
+				ulCount = pLz->ulLiteralsLeft;
+			}
+			if(ulCount > ulLeft) {
+				ulCount = ulLeft;
+			}
+			pLz->ulLiteralsLeft -= ulCount;
+			ulLeft -= ulCount;
+			const UBYTE *pSrc = &pLz->pIn[pLz->uwInPos];
+			pLz->uwInPos += ulCount;
+			do {
+				ULONG ulRun = assetLzWindowRun(ulCount, uwWindowPos);
+				assetLzCopy(pDest, pSrc, ulRun);
+				assetLzCopy(&pWindow[uwWindowPos], pSrc, ulRun);
+				pDest += ulRun;
+				pSrc += ulRun;
+				uwWindowPos = (uwWindowPos + ulRun) & ASSET_LZ_WINDOW_MASK;
+				ulCount -= ulRun;
+			} while(ulCount);
+		}
+		else if(pLz->ulMatchLeft) {
+			ULONG ulCount = pLz->ulMatchLeft;
+			if(ulCount > ulLeft) {
+				ulCount = ulLeft;
+			}
+			pLz->ulMatchLeft -= ulCount;
+			ulLeft -= ulCount;
+			// Match may overlap bytes being written, so it's copied in runs no
+			// longer than its distance - each one only reads bytes already there.
+			UWORD uwSrcPos = (uwWindowPos - pLz->uwMatchDistance) & ASSET_LZ_WINDOW_MASK;
+			do {
+				ULONG ulRun = ulCount;
+				if(ulRun > pLz->uwMatchDistance) {
+					ulRun = pLz->uwMatchDistance;
+				}
+				ulRun = assetLzWindowRun(ulRun, uwSrcPos);
+				ulRun = assetLzWindowRun(ulRun, uwWindowPos);
+				assetLzCopy(pDest, &pWindow[uwSrcPos], ulRun);
+				assetLzCopy(&pWindow[uwWindowPos], &pWindow[uwSrcPos], ulRun);
+				pDest += ulRun;
+				uwSrcPos = (uwSrcPos + ulRun) & ASSET_LZ_WINDOW_MASK;
+				uwWindowPos = (uwWindowPos + ulRun) & ASSET_LZ_WINDOW_MASK;
+				ulCount -= ulRun;
+			} while(ulCount);
+		}
+		else if(pLz->isMatchPending) {
+			UBYTE ubHi = 0, ubLo = 0;
+			isOk = assetLzFetch(pLz, &ubHi) && assetLzFetch(pLz, &ubLo);
+			// Corrupt distance past window would read stale data, and encoded
+			// 0xFFFF would wrap to 0 in UWORD, so copy loop would never end.
+			ULONG ulDistance = ((ubHi << 8) | ubLo) + 1;
+			if(ulDistance > ASSET_LZ_WINDOW_SIZE) {
+				isOk = 0;
+				break;
+			}
+			pLz->uwMatchDistance = ulDistance;
+			ULONG ulLength = pLz->ubMatchNibble;
+			if(isOk && ulLength == ASSET_LZ_NIBBLE_MAX) {
+				isOk = assetLzFetchLength(pLz, &ulLength);
+			}
+			pLz->ulMatchLeft = ulLength + ASSET_LZ_MATCH_MIN;
+			pLz->isMatchPending = 0;
+		}
+		else {
+			UBYTE ubToken = 0;
+			isOk = assetLzFetch(pLz, &ubToken);
+			ULONG ulLength = ubToken >> 4;
+			if(isOk && ulLength == ASSET_LZ_NIBBLE_MAX) {
+				isOk = assetLzFetchLength(pLz, &ulLength);
+			}
+			pLz->ulLiteralsLeft = ulLength;
+			pLz->ubMatchNibble = ubToken & ASSET_LZ_NIBBLE_MAX;
+			pLz->isMatchPending = 1;
+		}
+	}
+
+	pLz->uwWindowPos = uwWindowPos;
+	ulSize -= ulLeft;
+	pLz->ulOutLeft = isOk ? pLz->ulOutLeft - ulSize : 0;
+	return ulSize;
+}
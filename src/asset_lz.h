@@ -0,0 +1,80 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_ASSET_LZ_H
+#define SURVIVOR_ASSET_LZ_H
+
+// Streaming decompressor of LZ data made by tools/asset_pack. Shared with
+// the packer, which decompresses all it has compressed to verify it.
+// With ASSET_LZ_HOST defined, ACE integer types are defined here.
+//
+// Stream is a sequence of:
+//   UBYTE token: literal count in high nibble, match length - 4 in low one
+//   length extension bytes if literal count nibble is 15, each 255 continues
+//   literals
+//   UWORD big-endian match distance - 1
+//   length extension bytes if match length nibble is 15
+// Last sequence may end after its literals. Stream end isn't marked,
+// decompressed size is known from archive's manifest.
+
+#if defined(ASSET_LZ_HOST)
+#include <stdint.h>
+typedef uint8_t UBYTE;
+typedef uint16_t UWORD;
+typedef uint32_t ULONG;
+#else
+#include <ace/types.h>
+#endif
+
+#define ASSET_LZ_WINDOW_SIZE 8192
+#define ASSET_LZ_MATCH_MIN 4
+#define ASSET_LZ_NIBBLE_MAX 15
+#define ASSET_LZ_EXTENSION_MAX 255
+#define ASSET_LZ_IN_SIZE 512
+
+/**
+ * @brief Callback reading next part of compressed stream.
+ *
+ * @return Number of bytes read, zero if there's no more data.
+ */
+typedef ULONG (*tAssetLzCbRead)(void *pData, UBYTE *pDest, ULONG ulSize);
+
+typedef struct tAssetLz {
+	tAssetLzCbRead cbRead;
+	void *pReadData;
+	ULONG ulOutLeft; ///< Decompressed bytes yet to be returned.
+	ULONG ulLiteralsLeft;
+	ULONG ulMatchLeft;
+	UWORD uwMatchDistance;
+	UWORD uwWindowPos;
+	UWORD uwInPos;
+	UWORD uwInSize;
+	UBYTE ubMatchNibble;
+	UBYTE isMatchPending; ///< Literals are done, match is yet to be read.
+	UBYTE pIn[ASSET_LZ_IN_SIZE];
+	UBYTE pWindow[ASSET_LZ_WINDOW_SIZE]; ///< Last decompressed bytes.
+} tAssetLz;
+
+/**
+ * @brief Prepares decompressor for new stream.
+ *
+ * @param ulSize Decompressed size of the stream.
+ * @param cbRead Callback used for reading compressed data in chunks.
+ * @param pReadData Pointer passed to cbRead.
+ */
+void assetLzInit(
+	tAssetLz *pLz, ULONG ulSize, tAssetLzCbRead cbRead, void *pReadData
+);
+
+/**
+ * @brief Decompresses next part of stream, continuing where previous call
+ * has ended. Destination may be in chip RAM, since it's written only once
+ * per byte - back references are read from decompressor's own window.
+ *
+ * @return Number of bytes written, less than ulSize at stream end. On
+ * truncated stream, stream is ended early.
+ */
+ULONG assetLzRead(tAssetLz *pLz, UBYTE *pDest, ULONG ulSize);
+
+#endif // SURVIVOR_ASSET_LZ_H
@@ -3,12 +3,49 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "assets.h"
+#include <ace/managers/game.h>
+#include <ace/managers/log.h>
+#include <ace/contrib/managers/audio_mixer.h>
+#include "audio_tier.h"
 #include "game.h"
+#include "sfx_bank.h"
+#include "asset_archive.h"
+
+// Same order as SFX_BANK_SOURCES in CMakeLists.txt.
+typedef enum tSfxId {
+	SFX_ID_RIFLE,
+	SFX_ID_ASSAULT,
+	SFX_ID_SMG,
+	SFX_ID_SHOTGUN,
+	SFX_ID_IMPACT,
+	SFX_ID_BITE,
+	SFX_ID_RELOAD_1,
+	SFX_ID_RELOAD_2,
+	SFX_ID_RELOAD_FINAL,
+	SFX_ID_DEATH,
+	SFX_ID_EXPLOSION,
+	SFX_ID_COUNT
+} tSfxId;
+
+// Samples must be divided by software channel count of the mixer build
+// playing them, otherwise all channels at peak overflow the 8-bit mix.
+_Static_assert(
+	GAME_SFX_BANK_DIVIDE >= GAME_AUDIO_MIXER_SW_CHANNELS &&
+	GAME_SFX_BANK_020_DIVIDE >= GAME_AUDIO_MIXER_020_SW_CHANNELS,
+	"Sound bank isn't divided for its mixer build's channel count"
+);
+
+static const char *s_pSfxBankPaths[AUDIO_TIER_COUNT] = {
+	[AUDIO_TIER_A500] = "sfx/game.bank",
+	[AUDIO_TIER_020] = "sfx/game_020.bank",
+};
+
+static tSfxBank *s_pSfxBank;
 
 void assetsGlobalCreate(void) {
-	g_pFont = fontCreateFromPath("data/uni54.fnt");
+	g_pFont = fontCreateFromFd(assetArchiveOpen("uni54.fnt", 0));
 	g_pLineBuffer = fontCreateTextBitMap(GAME_MAIN_VPORT_SIZE_X, g_pFont->uwHeight);
-	g_pModSamples = ptplayerSampleDataCreateFromPath("data/music.samplepack");
+	g_pModSamples = ptplayerSampleDataCreateFromFd(assetArchiveOpen("music.samplepack", 0));
 }
 
 void assetsGlobalDestroy(void) {
@@ -19,25 +56,47 @@ void assetsGlobalDestroy(void) {
 }
 
 void assetsGameCreate(void) {
-	g_pFontSmall = fontCreateFromPath("data/uni54_small.fnt");
-	g_pLogo = bitmapCreateFromPath("data/logo.bm", 0);
-	g_pPerkIcons = bitmapCreateFromPath("data/perk_icons.bm", 0);
-
-	g_pModGame = ptplayerModCreateFromPath("data/game.mod");
-	g_pModMenu = ptplayerModCreateFromPath("data/menu.mod");
-	g_pModGameOver = ptplayerModCreateFromPath("data/dead_hare.mod");
-
-	g_pSfxRifle = ptplayerSfxCreateFromPath("data/sfx/rifle_shot_1.sfx", 1);
-	g_pSfxAssault = ptplayerSfxCreateFromPath("data/sfx/assault_shot_1.sfx", 1);
-	g_pSfxSmg = ptplayerSfxCreateFromPath("data/sfx/smg_shot_1.sfx", 1);
-	g_pSfxShotgun = ptplayerSfxCreateFromPath("data/sfx/shotgun_shot_1.sfx", 1);
-	g_pSfxImpact = ptplayerSfxCreateFromPath("data/sfx/impact_1.sfx", 1);
-	g_pSfxBite = ptplayerSfxCreateFromPath("data/sfx/bite_1.sfx", 1);
-	g_pSfxReloadClicks[0] = ptplayerSfxCreateFromPath("data/sfx/reload_1.sfx", 1);
-	g_pSfxReloadClicks[1] = ptplayerSfxCreateFromPath("data/sfx/reload_2.sfx", 1);
-	g_pSfxReloadFinal = ptplayerSfxCreateFromPath("data/sfx/reload_final.sfx", 1);
-	g_pSfxDeath = ptplayerSfxCreateFromPath("data/sfx/death.sfx", 1);
-	g_pSfxExplosion = ptplayerSfxCreateFromPath("data/sfx/explosion.sfx", 1);
+	g_pFontSmall = fontCreateFromFd(assetArchiveOpen("uni54_small.fnt", 0));
+	g_pLogo = assetArchiveBitmapCreate("logo.bm");
+	g_pPerkIcons = assetArchiveBitmapCreate("perk_icons.bm");
+
+	g_pModGame = ptplayerModCreateFromFd(assetArchiveOpen("game.mod", 0));
+	g_pModMenu = ptplayerModCreateFromFd(assetArchiveOpen("menu.mod", 0));
+	g_pModGameOver = ptplayerModCreateFromFd(assetArchiveOpen("dead_hare.mod", 0));
+
+	UBYTE ubMixerChannels = audioMixerGetChannelCount();
+	s_pSfxBank = sfxBankCreateFromFd(
+		assetArchiveOpen(s_pSfxBankPaths[audioTierGet()], 0), 1
+	);
+	if(
+		!s_pSfxBank || s_pSfxBank->ubSfxCount != SFX_ID_COUNT ||
+		s_pSfxBank->ubDivide < ubMixerChannels
+	) {
+		logWrite(
+			"ERR: Sound bank not loaded or has %hhu sfx divided by %hhu instead of %d for %hhu channels\n",
+			s_pSfxBank ? s_pSfxBank->ubSfxCount : 0,
+			s_pSfxBank ? s_pSfxBank->ubDivide : 0,
+			SFX_ID_COUNT, ubMixerChannels
+		);
+		if(s_pSfxBank) {
+			sfxBankDestroy(s_pSfxBank);
+			s_pSfxBank = 0;
+		}
+		// Game can't go on without its sounds, leave before gameplay starts
+		gameExit();
+		return;
+	}
+	g_pSfxRifle = &s_pSfxBank->pSfxs[SFX_ID_RIFLE];
+	g_pSfxAssault = &s_pSfxBank->pSfxs[SFX_ID_ASSAULT];
+	g_pSfxSmg = &s_pSfxBank->pSfxs[SFX_ID_SMG];
+	g_pSfxShotgun = &s_pSfxBank->pSfxs[SFX_ID_SHOTGUN];
+	g_pSfxImpact = &s_pSfxBank->pSfxs[SFX_ID_IMPACT];
+	g_pSfxBite = &s_pSfxBank->pSfxs[SFX_ID_BITE];
+	g_pSfxReloadClicks[0] = &s_pSfxBank->pSfxs[SFX_ID_RELOAD_1];
+	g_pSfxReloadClicks[1] = &s_pSfxBank->pSfxs[SFX_ID_RELOAD_2];
+	g_pSfxReloadFinal = &s_pSfxBank->pSfxs[SFX_ID_RELOAD_FINAL];
+	g_pSfxDeath = &s_pSfxBank->pSfxs[SFX_ID_DEATH];
+	g_pSfxExplosion = &s_pSfxBank->pSfxs[SFX_ID_EXPLOSION];
 }
 
 void assetsGameDestroy(void) {
@@ -49,17 +108,9 @@ void assetsGameDestroy(void) {
 	ptplayerModDestroy(g_pModMenu);
 	ptplayerModDestroy(g_pModGameOver);
 
-	ptplayerSfxDestroy(g_pSfxRifle);
-	ptplayerSfxDestroy(g_pSfxAssault);
-	ptplayerSfxDestroy(g_pSfxSmg);
-	ptplayerSfxDestroy(g_pSfxShotgun);
-	ptplayerSfxDestroy(g_pSfxImpact);
-	ptplayerSfxDestroy(g_pSfxBite);
-	ptplayerSfxDestroy(g_pSfxReloadClicks[0]);
-	ptplayerSfxDestroy(g_pSfxReloadClicks[1]);
-	ptplayerSfxDestroy(g_pSfxReloadFinal);
-	ptplayerSfxDestroy(g_pSfxDeath);
-	ptplayerSfxDestroy(g_pSfxExplosion);
+	if(s_pSfxBank) {
+		sfxBankDestroy(s_pSfxBank);
+	}
 }
 
 tFont *g_pFont;
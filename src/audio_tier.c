@@ -0,0 +1,88 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "audio_tier.h"
+#include <exec/execbase.h>
+#include <proto/exec.h> // SysBase
+#include <ace/macros.h>
+#include <ace/managers/log.h>
+#include <ace/managers/memory.h>
+#include <ace/utils/custom.h>
+#include <ace/contrib/managers/audio_mixer.h>
+
+#define AUDIO_TIER_LINES_PER_FRAME 313
+#define AUDIO_TIER_PROBE_CHANNELS 4
+// Mixer's output samples per PAL frame.
+#define AUDIO_TIER_PROBE_SAMPLES (3546895 / GAME_AUDIO_MIXER_PERIOD / 50)
+// ~10% of the frame. Mixer's asm is faster than the probe's C, so the tier's
+// actual cost stays below that.
+#define AUDIO_TIER_PROBE_BUDGET_LINES 32
+// Best of several runs, so that interrupts won't skew the result.
+#define AUDIO_TIER_PROBE_RUNS 3
+
+static tAudioTier s_eTier;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static UWORD audioTierGetLine(void) {
+	return ((g_pCustom->vposr & 1) << 8) | (g_pCustom->vhposr >> 8);
+}
+
+static UWORD audioTierProbe(void) {
+	ULONG ulSrcSize = AUDIO_TIER_PROBE_CHANNELS * AUDIO_TIER_PROBE_SAMPLES;
+	BYTE *pSrc = memAllocChipClear(ulSrcSize);
+	BYTE *pDst = memAllocChip(AUDIO_TIER_PROBE_SAMPLES);
+	UWORD uwBestLines = AUDIO_TIER_LINES_PER_FRAME;
+
+	for(UBYTE ubRun = 0; ubRun < AUDIO_TIER_PROBE_RUNS; ++ubRun) {
+		UWORD uwStart = audioTierGetLine();
+		const BYTE *pChannel = pSrc;
+		for(UWORD i = 0; i < AUDIO_TIER_PROBE_SAMPLES; ++i) {
+			pDst[i] = (
+				pChannel[0 * AUDIO_TIER_PROBE_SAMPLES] +
+				pChannel[1 * AUDIO_TIER_PROBE_SAMPLES] +
+				pChannel[2 * AUDIO_TIER_PROBE_SAMPLES] +
+				pChannel[3 * AUDIO_TIER_PROBE_SAMPLES]
+			);
+			++pChannel;
+		}
+		UWORD uwLines = (
+			audioTierGetLine() + AUDIO_TIER_LINES_PER_FRAME - uwStart
+		) % AUDIO_TIER_LINES_PER_FRAME;
+		uwBestLines = MIN(uwBestLines, uwLines);
+	}
+
+	memFree(pDst, AUDIO_TIER_PROBE_SAMPLES);
+	memFree(pSrc, ulSrcSize);
+	return uwBestLines;
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+tAudioTier audioTierSelect(void) {
+	logBlockBegin("audioTierSelect()");
+	tAudioTier eTier = AUDIO_TIER_A500;
+	if(SysBase->AttnFlags & AFF_68020) {
+		UWORD uwProbeLines = audioTierProbe();
+		logWrite(
+			"68020+ detected, probe: %hu lines, budget: %d\n",
+			uwProbeLines, AUDIO_TIER_PROBE_BUDGET_LINES
+		);
+		if(uwProbeLines <= AUDIO_TIER_PROBE_BUDGET_LINES) {
+			eTier = AUDIO_TIER_020;
+		}
+	}
+
+#if defined(MIXER_VARIANTS)
+	audioMixerSelectVariant(eTier);
+#endif
+	logWrite("Audio tier: %d\n", eTier);
+	logBlockEnd("audioTierSelect()");
+	s_eTier = eTier;
+	return eTier;
+}
+
+tAudioTier audioTierGet(void) {
+	return s_eTier;
+}
@@ -0,0 +1,34 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_AUDIO_TIER_H
+#define SURVIVOR_AUDIO_TIER_H
+
+#include <ace/types.h>
+
+/**
+ * @brief Mixer builds, in order of AUDIO_MIXER_VARIANTS.
+ */
+typedef enum tAudioTier {
+	AUDIO_TIER_A500, ///< 68000 mixer code, 3 software channels.
+	AUDIO_TIER_020, ///< 68020 mixer code, 4 software channels.
+	AUDIO_TIER_COUNT,
+} tAudioTier;
+
+/**
+ * @brief Picks mixer build by detected CPU & measured headroom.
+ * 68020+ machines run a probe mixing 4 channels for one frame in C and get
+ * the faster tier only if it fits in the budget, so that e.g. accelerators
+ * running from chip RAM stay on the A500 one. Call before audioMixerCreate().
+ *
+ * @return Selected tier.
+ */
+tAudioTier audioTierSelect(void);
+
+/**
+ * @brief Returns tier picked by last audioTierSelect() call.
+ */
+tAudioTier audioTierGet(void);
+
+#endif // SURVIVOR_AUDIO_TIER_H
@@ -0,0 +1,182 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copper-driven backend of blit_queue - queued blits are written as blitter
+// register moves into the back copperlist and executed by the copper at the
+// top of the frame in which that copperlist gets displayed.
+
+#if defined(GAME_BLIT_COPPER)
+
+#include "blit_queue.h"
+#include <ace/managers/blit.h>
+#include <ace/managers/copper.h>
+#include <ace/managers/log.h>
+#include <ace/managers/system.h>
+#include <ace/utils/custom.h>
+
+// Still in vertical blank, so that blits are done before display starts.
+#define BLIT_COPPER_START_LINE 4
+#define BLIT_COPPER_TAIL_POS (1 + BLIT_QUEUE_COP_BLIT_COUNT * BLIT_QUEUE_COP_CMDS_PER_BLIT)
+
+static UWORD s_uwCopPos;
+static tView *s_pView;
+static tBlitQueueCmd s_pCmds[BLIT_QUEUE_COP_BLIT_COUNT];
+static UBYTE s_ubCmdCount; ///< Blits written to back copperlist.
+static tCopCmd * volatile s_pArmedSegment; ///< Segment awaiting copper run.
+static volatile UBYTE s_ubArmedCount;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+__attribute__((always_inline))
+static inline tCopCmd *blitCopperGetBackSegment(void) {
+	return &s_pView->pCopList->pBackBfr->pList[s_uwCopPos];
+}
+
+static void blitCopperDisable(tCopCmd *pCmd, UWORD uwCount) {
+	while(uwCount--) {
+		copSetMove(&(pCmd++)->sMove, &g_pCustom->noop, 0);
+	}
+}
+
+static void blitCopperDisableSegment(tCopCmd *pSegment, UBYTE ubBlitCount) {
+	blitCopperDisable(&pSegment[1], ubBlitCount * BLIT_QUEUE_COP_CMDS_PER_BLIT);
+	blitCopperDisable(&pSegment[BLIT_COPPER_TAIL_POS], 2);
+}
+
+__attribute__((always_inline))
+static inline tCopCmd *blitCopperSetWaitBlitter(tCopCmd *pCmd) {
+	copSetWait(&pCmd->sWait, 0, 0);
+	// Don't compare beam position at all, only wait for the blitter
+	pCmd->sWait.bfVE = 0;
+	pCmd->sWait.bfHE = 0;
+	pCmd->sWait.bfBlitterIgnore = 0;
+	return pCmd + 1;
+}
+
+__attribute__((always_inline))
+static inline tCopCmd *blitCopperSetPtr(
+	tCopCmd *pCmd, volatile void *pReg, const UBYTE *pValue
+) {
+	volatile UWORD *pRegHalves = (volatile UWORD*)pReg;
+	copSetMove(&pCmd[0].sMove, &pRegHalves[0], (ULONG)pValue >> 16);
+	copSetMove(&pCmd[1].sMove, &pRegHalves[1], (ULONG)pValue & 0xFFFF);
+	return pCmd + 2;
+}
+
+static void blitCopperWriteBlit(
+	tCopCmd *pSegment, UBYTE ubBlit, const tBlitQueueCmd *pBlit
+) {
+	tCopCmd *pCmd = &pSegment[1 + ubBlit * BLIT_QUEUE_COP_CMDS_PER_BLIT];
+	pCmd = blitCopperSetWaitBlitter(pCmd);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltcon0, pBlit->uwBltCon0);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltcon1, pBlit->uwBltCon1);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltafwm, pBlit->uwFirstMask);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltalwm, pBlit->uwLastMask);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltamod, pBlit->wModA);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltbmod, pBlit->wModB);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltcmod, pBlit->wModC);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltdmod, pBlit->wModD);
+	copSetMove(&(pCmd++)->sMove, &g_pCustom->bltadat, pBlit->uwDataA);
+	pCmd = blitCopperSetPtr(pCmd, &g_pCustom->bltapt, pBlit->pA);
+	pCmd = blitCopperSetPtr(pCmd, &g_pCustom->bltbpt, pBlit->pB);
+	pCmd = blitCopperSetPtr(pCmd, &g_pCustom->bltcpt, pBlit->pC);
+	pCmd = blitCopperSetPtr(pCmd, &g_pCustom->bltdpt, pBlit->pD);
+	copSetMove(&pCmd->sMove, &g_pCustom->bltsize, pBlit->uwBltSize);
+}
+
+static void onCopper(
+	UNUSED_ARG REGARG(volatile tCustom *pCustom, "a0"),
+	UNUSED_ARG REGARG(volatile void *pData, "a1")
+) {
+	tCopCmd *pSegment = s_pArmedSegment;
+	if(pSegment) {
+		// Copperlist will be displayed again before next swap - prevent
+		// doing same blits twice.
+		blitCopperDisableSegment(pSegment, s_ubArmedCount);
+		s_pArmedSegment = 0;
+	}
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void blitQueueCreate(tView *pView, UWORD uwCopPos) {
+	logBlockBegin("blitQueueCreate(pView: %p, uwCopPos: %hu)", pView, uwCopPos);
+	s_pView = pView;
+	s_uwCopPos = uwCopPos;
+	s_ubCmdCount = 0;
+	s_ubArmedCount = 0;
+	s_pArmedSegment = 0;
+
+	tCopBfr *pBuffers[] = {pView->pCopList->pFrontBfr, pView->pCopList->pBackBfr};
+	for(UBYTE i = 0; i < 2; ++i) {
+		tCopCmd *pSegment = &pBuffers[i]->pList[uwCopPos];
+		copSetWait(&pSegment[0].sWait, 0, BLIT_COPPER_START_LINE);
+		blitCopperDisableSegment(pSegment, BLIT_QUEUE_COP_BLIT_COUNT);
+	}
+
+	systemSetInt(INTB_COPER, onCopper, 0);
+	// Allow copper to write blitter registers
+	g_pCustom->copcon = BV(1);
+	logBlockEnd("blitQueueCreate()");
+}
+
+void blitQueueDestroy(void) {
+	logBlockBegin("blitQueueDestroy()");
+	blitQueueFrameBegin();
+	g_pCustom->copcon = 0;
+	systemSetInt(INTB_COPER, 0, 0);
+	logBlockEnd("blitQueueDestroy()");
+}
+
+tBlitQueueCmd *blitQueueAlloc(void) {
+	if(s_ubCmdCount == BLIT_QUEUE_COP_BLIT_COUNT) {
+		// Segment full - do what's already there with CPU
+		blitQueueFence();
+	}
+	return &s_pCmds[s_ubCmdCount];
+}
+
+void blitQueueCommit(void) {
+	blitCopperWriteBlit(
+		blitCopperGetBackSegment(), s_ubCmdCount, &s_pCmds[s_ubCmdCount]
+	);
+	++s_ubCmdCount;
+}
+
+void blitQueueFence(void) {
+	if(!s_ubCmdCount) {
+		return;
+	}
+
+	for(UBYTE i = 0; i < s_ubCmdCount; ++i) {
+		blitWait();
+		blitQueueExecute(&s_pCmds[i]);
+	}
+	blitCopperDisableSegment(blitCopperGetBackSegment(), s_ubCmdCount);
+	s_ubCmdCount = 0;
+}
+
+void blitQueueFrameBegin(void) {
+	while(s_pArmedSegment) continue;
+	blitWait();
+
+	// Blits left behind by frame which didn't reach blitQueueFrameEnd()
+	blitQueueFence();
+}
+
+void blitQueueFrameEnd(void) {
+	if(!s_ubCmdCount) {
+		return;
+	}
+
+	tCopCmd *pSegment = blitCopperGetBackSegment();
+	tCopCmd *pTail = blitCopperSetWaitBlitter(&pSegment[BLIT_COPPER_TAIL_POS]);
+	copSetMove(&pTail->sMove, &g_pCustom->intreq, INTF_SETCLR | INTF_COPER);
+
+	s_ubArmedCount = s_ubCmdCount;
+	s_pArmedSegment = pSegment;
+	s_ubCmdCount = 0;
+}
+
+#endif // defined(GAME_BLIT_COPPER)
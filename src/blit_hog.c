@@ -0,0 +1,148 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "blit_hog.h"
+#include <ace/managers/log.h>
+#include <ace/utils/custom.h>
+
+#define BLIT_HOG_LINES_PER_FRAME 313
+// Every n-th frame is run with opposite setting to measure it.
+#define BLIT_HOG_PROBE_INTERVAL 8
+#define BLIT_HOG_EVAL_INTERVAL 128
+// Longer samples were interrupted by something else than blitter contention.
+#define BLIT_HOG_SAMPLE_MAX (2 * BLIT_HOG_LINES_PER_FRAME)
+
+typedef struct tBlitHogStats {
+	ULONG pTimes[2]; ///< Accumulated phase time, indexed by hog setting.
+	UWORD pSamples[2];
+	UBYTE isHog; ///< Currently preferred setting.
+} tBlitHogStats;
+
+static const volatile ULONG *s_pFrameCount;
+static tBlitHogStats s_pStats[BLIT_HOG_PHASE_COUNT];
+static tBlitHogPhase s_eCurrentPhase;
+static UBYTE s_isCurrentHog;
+static ULONG s_ulPhaseStart;
+static UWORD s_uwFrame;
+
+// Matches hard-coded setup from before the policy was introduced.
+static const UBYTE s_pDefaultHog[BLIT_HOG_PHASE_COUNT] = {
+	[BLIT_HOG_PHASE_UNDRAW] = 0,
+	[BLIT_HOG_PHASE_DRAW] = 1,
+	[BLIT_HOG_PHASE_HUD] = 1,
+};
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static ULONG blitHogGetTime(void) {
+	ULONG ulFrame;
+	UWORD uwLine;
+	do {
+		ulFrame = *s_pFrameCount;
+		uwLine = ((g_pCustom->vposr & 1) << 8) | (g_pCustom->vhposr >> 8);
+	} while(ulFrame != *s_pFrameCount);
+	return ulFrame * BLIT_HOG_LINES_PER_FRAME + uwLine;
+}
+
+static void blitHogSetDma(UBYTE isHog) {
+	g_pCustom->dmacon = isHog ? (DMAF_SETCLR | DMAF_BLITHOG) : DMAF_BLITHOG;
+}
+
+#if !defined(GAME_BLITHOG_FIXED)
+static void blitHogEvaluate(void) {
+	for(tBlitHogPhase ePhase = 0; ePhase < BLIT_HOG_PHASE_COUNT; ++ePhase) {
+		tBlitHogStats *pStats = &s_pStats[ePhase];
+		if(!pStats->pSamples[0] || !pStats->pSamples[1]) {
+			continue;
+		}
+
+		ULONG ulAvgOff = pStats->pTimes[0] / pStats->pSamples[0];
+		ULONG ulAvgOn = pStats->pTimes[1] / pStats->pSamples[1];
+		UBYTE isHog = pStats->isHog;
+		// Switch only on clear difference so that noise won't flip-flop it
+		if(isHog && ulAvgOff + ulAvgOff / 16 < ulAvgOn) {
+			isHog = 0;
+		}
+		else if(!isHog && ulAvgOn + ulAvgOn / 16 < ulAvgOff) {
+			isHog = 1;
+		}
+		if(isHog != pStats->isHog) {
+			logWrite(
+				"Blitter hog in phase %d: %hhu -> %hhu, avg lines off: %lu, on: %lu\n",
+				ePhase, pStats->isHog, isHog, ulAvgOff, ulAvgOn
+			);
+			pStats->isHog = isHog;
+		}
+
+		// Keep some history, but let the newer samples matter more
+		for(UBYTE i = 0; i < 2; ++i) {
+			pStats->pTimes[i] /= 2;
+			pStats->pSamples[i] /= 2;
+		}
+	}
+}
+#endif
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void blitHogReset(const volatile ULONG *pFrameCount) {
+	s_pFrameCount = pFrameCount;
+	s_eCurrentPhase = BLIT_HOG_PHASE_NONE;
+	s_uwFrame = 0;
+	for(tBlitHogPhase ePhase = 0; ePhase < BLIT_HOG_PHASE_COUNT; ++ePhase) {
+		s_pStats[ePhase] = (tBlitHogStats){.isHog = s_pDefaultHog[ePhase]};
+	}
+}
+
+void blitHogPhaseBegin(tBlitHogPhase ePhase) {
+	if(ePhase == s_eCurrentPhase) {
+		return;
+	}
+	blitHogPhaseEnd();
+
+#if defined(GAME_BLITHOG_FIXED)
+	s_isCurrentHog = GAME_BLITHOG_FIXED;
+#else
+	if(ePhase == BLIT_HOG_PHASE_UNDRAW) {
+		if(++s_uwFrame == BLIT_HOG_EVAL_INTERVAL) {
+			s_uwFrame = 0;
+			blitHogEvaluate();
+		}
+	}
+	s_isCurrentHog = s_pStats[ePhase].isHog;
+	if(s_uwFrame % BLIT_HOG_PROBE_INTERVAL == 0) {
+		s_isCurrentHog = !s_isCurrentHog;
+	}
+#endif
+	blitHogSetDma(s_isCurrentHog);
+	s_eCurrentPhase = ePhase;
+	s_ulPhaseStart = blitHogGetTime();
+}
+
+void blitHogPhaseEnd(void) {
+	if(s_eCurrentPhase == BLIT_HOG_PHASE_NONE) {
+		return;
+	}
+
+	ULONG ulElapsed = blitHogGetTime() - s_ulPhaseStart;
+	if(ulElapsed < BLIT_HOG_SAMPLE_MAX) {
+		tBlitHogStats *pStats = &s_pStats[s_eCurrentPhase];
+		pStats->pTimes[s_isCurrentHog] += ulElapsed;
+		++pStats->pSamples[s_isCurrentHog];
+	}
+	s_eCurrentPhase = BLIT_HOG_PHASE_NONE;
+}
+
+void blitHogDiscard(void) {
+	s_eCurrentPhase = BLIT_HOG_PHASE_NONE;
+}
+
+ULONG blitHogGetAverage(tBlitHogPhase ePhase) {
+	const tBlitHogStats *pStats = &s_pStats[ePhase];
+	UWORD uwSamples = pStats->pSamples[0] + pStats->pSamples[1];
+	if(!uwSamples) {
+		return 0;
+	}
+	return (pStats->pTimes[0] + pStats->pTimes[1]) / uwSamples;
+}
@@ -0,0 +1,53 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_BLIT_HOG_H
+#define SURVIVOR_BLIT_HOG_H
+
+#include <ace/types.h>
+
+typedef enum tBlitHogPhase {
+	BLIT_HOG_PHASE_UNDRAW,
+	BLIT_HOG_PHASE_DRAW,
+	BLIT_HOG_PHASE_HUD,
+	BLIT_HOG_PHASE_COUNT,
+	BLIT_HOG_PHASE_NONE = BLIT_HOG_PHASE_COUNT,
+} tBlitHogPhase;
+
+/**
+ * @brief Resets blitter priority policy.
+ * Unless GAME_BLITHOG_FIXED is defined, each phase periodically runs with
+ * opposite DMAF_BLITHOG setting and the one with shorter average phase time
+ * is picked. With GAME_BLITHOG_FIXED defined as 0 or 1, given setting is
+ * used in all phases.
+ *
+ * @param pFrameCount Counter incremented on each vertical blank, used for
+ * measuring phase time along with beam position.
+ */
+void blitHogReset(const volatile ULONG *pFrameCount);
+
+/**
+ * @brief Ends timing of current phase and sets up blitter priority for
+ * the next one. Does nothing if given phase is already active.
+ */
+void blitHogPhaseBegin(tBlitHogPhase ePhase);
+
+/**
+ * @brief Ends timing of current phase without starting the next one.
+ */
+void blitHogPhaseEnd(void);
+
+/**
+ * @brief Drops measurement of current phase, e.g. when game loop got
+ * interrupted by other gamestate.
+ */
+void blitHogDiscard(void);
+
+/**
+ * @brief Returns average recent duration of given phase in raster lines,
+ * regardless of blitter priority setting used.
+ */
+ULONG blitHogGetAverage(tBlitHogPhase ePhase);
+
+#endif // SURVIVOR_BLIT_HOG_H
@@ -0,0 +1,184 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "blit_queue.h"
+#include <ace/managers/blit.h>
+#include <ace/managers/log.h>
+#include <ace/managers/system.h>
+#include <ace/utils/custom.h>
+
+// D = A | C
+#define BLIT_QUEUE_MINTERM_SET (MINTERM_A | MINTERM_C)
+// D = !A & C
+#define BLIT_QUEUE_MINTERM_CLEAR ((UBYTE)(~MINTERM_A & MINTERM_C))
+
+#if !defined(GAME_BLIT_COPPER)
+
+#define BLIT_QUEUE_SIZE 32
+#define BLIT_QUEUE_MASK (BLIT_QUEUE_SIZE - 1)
+
+static tBlitQueueCmd s_pCmds[BLIT_QUEUE_SIZE];
+static volatile UBYTE s_ubHead; ///< Next command to be started.
+static volatile UBYTE s_ubTail; ///< Next free command slot.
+static volatile UBYTE s_isBusy; ///< Blitter is processing queued command.
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+__attribute__((always_inline))
+static inline void blitQueueStartNext(void) {
+	const tBlitQueueCmd *pCmd = &s_pCmds[s_ubHead];
+	s_ubHead = (s_ubHead + 1) & BLIT_QUEUE_MASK;
+	blitQueueExecute(pCmd);
+}
+
+static void onBlitDone(
+	UNUSED_ARG REGARG(volatile tCustom *pCustom, "a0"),
+	UNUSED_ARG REGARG(volatile void *pData, "a1")
+) {
+	if(!s_isBusy) {
+		// Blit issued outside of the queue
+		return;
+	}
+
+	if(s_ubHead == s_ubTail) {
+		s_isBusy = 0;
+	}
+	else {
+		blitQueueStartNext();
+	}
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void blitQueueCreate(UNUSED_ARG tView *pView, UNUSED_ARG UWORD uwCopPos) {
+	logBlockBegin("blitQueueCreate()");
+	s_ubHead = 0;
+	s_ubTail = 0;
+	s_isBusy = 0;
+	systemSetInt(INTB_BLIT, onBlitDone, 0);
+	logBlockEnd("blitQueueCreate()");
+}
+
+void blitQueueDestroy(void) {
+	logBlockBegin("blitQueueDestroy()");
+	blitQueueFence();
+	systemSetInt(INTB_BLIT, 0, 0);
+	logBlockEnd("blitQueueDestroy()");
+}
+
+tBlitQueueCmd *blitQueueAlloc(void) {
+	// Queue full - wait for the interrupt to make some room
+	while(((s_ubTail + 1) & BLIT_QUEUE_MASK) == s_ubHead) continue;
+	return &s_pCmds[s_ubTail];
+}
+
+void blitQueueCommit(void) {
+	g_pCustom->intena = INTF_BLIT;
+	s_ubTail = (s_ubTail + 1) & BLIT_QUEUE_MASK;
+	if(!s_isBusy) {
+		// Let the last blit issued outside of the queue finish and discard its
+		// interrupt request so that it won't be taken as queued blit's one.
+		blitWait();
+		g_pCustom->intreq = INTF_BLIT;
+		g_pCustom->intreq = INTF_BLIT;
+		s_isBusy = 1;
+		blitQueueStartNext();
+	}
+	g_pCustom->intena = INTF_SETCLR | INTF_BLIT;
+}
+
+void blitQueueFence(void) {
+	while(s_isBusy) continue;
+}
+
+void blitQueueFrameBegin(void) {
+	blitQueueFence();
+}
+
+void blitQueueFrameEnd(void) {
+	// Blits are already being processed
+}
+
+#endif // !defined(GAME_BLIT_COPPER)
+
+void blitQueueExecute(const tBlitQueueCmd *pCmd) {
+	g_pCustom->bltcon0 = pCmd->uwBltCon0;
+	g_pCustom->bltcon1 = pCmd->uwBltCon1;
+	g_pCustom->bltafwm = pCmd->uwFirstMask;
+	g_pCustom->bltalwm = pCmd->uwLastMask;
+	g_pCustom->bltamod = pCmd->wModA;
+	g_pCustom->bltbmod = pCmd->wModB;
+	g_pCustom->bltcmod = pCmd->wModC;
+	g_pCustom->bltdmod = pCmd->wModD;
+	g_pCustom->bltadat = pCmd->uwDataA;
+	g_pCustom->bltapt = pCmd->pA;
+	g_pCustom->bltbpt = pCmd->pB;
+	g_pCustom->bltcpt = pCmd->pC;
+	g_pCustom->bltdpt = pCmd->pD;
+	g_pCustom->bltsize = pCmd->uwBltSize;
+}
+
+void blitQueueRect(
+	tBitMap *pDst, UWORD uwX, UWORD uwY, UWORD uwWidth, UWORD uwHeight,
+	UBYTE ubColor
+) {
+	UWORD uwFirstWord = uwX >> 4;
+	UWORD uwBlitWords = ((uwX + uwWidth - 1) >> 4) - uwFirstWord + 1;
+	UWORD uwFirstMask = 0xFFFF >> (uwX & 0xF);
+	UWORD uwLastMask = 0xFFFF << (15 - ((uwX + uwWidth - 1) & 0xF));
+	WORD wModulo = pDst->BytesPerRow - uwBlitWords * 2;
+	ULONG ulOffset = uwY * pDst->BytesPerRow + uwFirstWord * 2;
+
+	for(UBYTE ubPlane = 0; ubPlane < pDst->Depth; ++ubPlane) {
+		tBlitQueueCmd *pCmd = blitQueueAlloc();
+		pCmd->uwBltCon0 = USEC | USED | (
+			(ubColor & BV(ubPlane)) ? BLIT_QUEUE_MINTERM_SET : BLIT_QUEUE_MINTERM_CLEAR
+		);
+		pCmd->uwBltCon1 = 0;
+		pCmd->uwFirstMask = uwFirstMask;
+		pCmd->uwLastMask = uwLastMask;
+		pCmd->wModA = 0;
+		pCmd->wModB = 0;
+		pCmd->wModC = wModulo;
+		pCmd->wModD = wModulo;
+		pCmd->uwDataA = 0xFFFF;
+		pCmd->pA = 0;
+		pCmd->pB = 0;
+		pCmd->pC = &pDst->Planes[ubPlane][ulOffset];
+		pCmd->pD = &pDst->Planes[ubPlane][ulOffset];
+		pCmd->uwBltSize = (uwHeight << HSIZEBITS) | uwBlitWords;
+		blitQueueCommit();
+	}
+}
+
+void blitQueueCopyAligned(
+	const tBitMap *pSrc, UWORD uwSrcX, UWORD uwSrcY,
+	tBitMap *pDst, UWORD uwDstX, UWORD uwDstY, UWORD uwWidth, UWORD uwHeight
+) {
+	UWORD uwBlitWords = uwWidth >> 4;
+	WORD wSrcModulo = pSrc->BytesPerRow - uwBlitWords * 2;
+	WORD wDstModulo = pDst->BytesPerRow - uwBlitWords * 2;
+	ULONG ulSrcOffset = uwSrcY * pSrc->BytesPerRow + (uwSrcX >> 3);
+	ULONG ulDstOffset = uwDstY * pDst->BytesPerRow + (uwDstX >> 3);
+	UBYTE ubPlaneCount = MIN(pSrc->Depth, pDst->Depth);
+
+	for(UBYTE ubPlane = 0; ubPlane < ubPlaneCount; ++ubPlane) {
+		tBlitQueueCmd *pCmd = blitQueueAlloc();
+		pCmd->uwBltCon0 = USEA | USED | MINTERM_A;
+		pCmd->uwBltCon1 = 0;
+		pCmd->uwFirstMask = 0xFFFF;
+		pCmd->uwLastMask = 0xFFFF;
+		pCmd->wModA = wSrcModulo;
+		pCmd->wModB = 0;
+		pCmd->wModC = 0;
+		pCmd->wModD = wDstModulo;
+		pCmd->uwDataA = 0;
+		pCmd->pA = &pSrc->Planes[ubPlane][ulSrcOffset];
+		pCmd->pB = 0;
+		pCmd->pC = 0;
+		pCmd->pD = &pDst->Planes[ubPlane][ulDstOffset];
+		pCmd->uwBltSize = (uwHeight << HSIZEBITS) | uwBlitWords;
+		blitQueueCommit();
+	}
+}
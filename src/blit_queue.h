@@ -0,0 +1,116 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_BLIT_QUEUE_H
+#define SURVIVOR_BLIT_QUEUE_H
+
+#include <ace/utils/bitmap.h>
+#include <ace/utils/extview.h>
+
+#if defined(GAME_BLIT_COPPER)
+#define BLIT_QUEUE_COP_BLIT_COUNT 16
+// Wait for blitter, 9 register moves, 4 pointer moves split in halves, size.
+#define BLIT_QUEUE_COP_CMDS_PER_BLIT (1 + 9 + 4 * 2 + 1)
+// Line wait + blits + final blitter wait + interrupt request.
+#define BLIT_QUEUE_COP_CMD_COUNT (\
+	1 + BLIT_QUEUE_COP_BLIT_COUNT * BLIT_QUEUE_COP_CMDS_PER_BLIT + 2 \
+)
+#else
+#define BLIT_QUEUE_COP_CMD_COUNT 0
+#endif
+
+/**
+ * @brief Register values of a single queued blit.
+ * bltadat is only relevant when channel A is disabled in bltcon0.
+ */
+typedef struct tBlitQueueCmd {
+	UWORD uwBltCon0;
+	UWORD uwBltCon1;
+	UWORD uwFirstMask;
+	UWORD uwLastMask;
+	WORD wModA;
+	WORD wModB;
+	WORD wModC;
+	WORD wModD;
+	UWORD uwDataA;
+	UBYTE *pA;
+	UBYTE *pB;
+	UBYTE *pC;
+	UBYTE *pD;
+	UWORD uwBltSize;
+} tBlitQueueCmd;
+
+/**
+ * @brief Sets up the queue.
+ * By default it's drained by blitter-finished interrupt. With GAME_BLIT_COPPER,
+ * commands are instead written into a copperlist segment which does the blits
+ * at the top of next frame.
+ *
+ * @param pView View with raw copperlist. Ignored by interrupt-driven queue.
+ * @param uwCopPos Position of BLIT_QUEUE_COP_CMD_COUNT instructions reserved
+ * for the queue in raw copperlist.
+ */
+void blitQueueCreate(tView *pView, UWORD uwCopPos);
+
+/**
+ * @brief Waits for queue to drain & removes its interrupt handler.
+ */
+void blitQueueDestroy(void);
+
+/**
+ * @brief Returns next free command slot, waiting for queue to drain if it's
+ * full. Fill all of its fields and call blitQueueCommit() afterwards.
+ */
+tBlitQueueCmd *blitQueueAlloc(void);
+
+/**
+ * @brief Adds previously allocated command to the queue, starting the blitter
+ * if it's idle.
+ */
+void blitQueueCommit(void);
+
+/**
+ * @brief Queued equivalent of blitRect().
+ */
+void blitQueueRect(
+	tBitMap *pDst, UWORD uwX, UWORD uwY, UWORD uwWidth, UWORD uwHeight,
+	UBYTE ubColor
+);
+
+/**
+ * @brief Queued equivalent of blitCopyAligned(). X positions & width must be
+ * multiples of 16.
+ */
+void blitQueueCopyAligned(
+	const tBitMap *pSrc, UWORD uwSrcX, UWORD uwSrcY,
+	tBitMap *pDst, UWORD uwDstX, UWORD uwDstY, UWORD uwWidth, UWORD uwHeight
+);
+
+/**
+ * @brief Programs blitter registers with given command right away.
+ * Doesn't wait for the blitter.
+ */
+void blitQueueExecute(const tBlitQueueCmd *pCmd);
+
+/**
+ * @brief Makes all queued blits done.
+ * Must be called before any blitter use outside of the queue, since it shares
+ * blitter registers, as well as before CPU accesses queued blit results.
+ * Copper-driven queue does the pending blits with CPU.
+ */
+void blitQueueFence(void);
+
+/**
+ * @brief Waits for blits queued in previous frame. Call before any other
+ * blitter use in the frame.
+ */
+void blitQueueFrameBegin(void);
+
+/**
+ * @brief Hands blits queued in current frame to the copper. Call right before
+ * copSwapBuffers().
+ */
+void blitQueueFrameEnd(void);
+
+#endif // SURVIVOR_BLIT_QUEUE_H
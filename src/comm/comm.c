@@ -4,13 +4,13 @@
 
 #include <comm/comm.h>
 #include <ace/managers/ptplayer.h>
-#include <ace/managers/rand.h>
 #include <ace/managers/system.h>
 #include <ace/managers/key.h>
 #include <ace/utils/chunky.h>
 #include <ace/contrib/managers/audio_mixer.h>
 #include "../game.h"
 #include "../assets.h"
+#include "../asset_archive.h"
 
 #define SFX_CHANNEL_KEY 0
 #define COMM_BUTTON_LABEL_Y 170
@@ -24,10 +24,16 @@
 #define COMM_PROGRESS_BAR_WIDTH (COMM_DISPLAY_WIDTH - 20)
 #define COMM_PROGRESS_BAR_HEIGHT 5
 #define COMM_PROGRESS_BAR_BORDER_DISTANCE 2
+#define COMM_EDGE_WIDTH 16
+#define COMM_EDGE_BG_HEIGHT (5 + 4 + 4 + 5)
 
 static tBitMap *s_pBmEdgesMask;
 static tBitMap *s_pBg;
 static tBitMap *s_pBmDraw;
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+static tBitMap *s_pBmEdgesBg; ///< Map background beneath edges, stacked.
+static UBYTE *s_pNextEdgeBg;
+#endif
 static UBYTE s_isCommShown = 0;
 // static const char *s_szPrevProgressText;
 
@@ -42,7 +48,12 @@ static void fixNextBackgroundEdge(UWORD uwX, UWORD uwY, UWORD uwHeight) {
 	UWORD uwBlitWidthInWords = 1;
 	ULONG ulOffsBCD = s_pBmDraw->BytesPerRow * (uwY + sOrigin.uwY) + ((uwX + sOrigin.uwX) / 8);
 	blitWait();
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	g_pCustom->bltbpt = (UBYTE*)((ULONG)g_pGamePristineBuffer->Planes[0] + ulOffsBCD);
+#else
+	g_pCustom->bltbpt = s_pNextEdgeBg;
+	s_pNextEdgeBg += s_pBmEdgesBg->BytesPerRow * uwHeight;
+#endif
 	g_pCustom->bltcpt = (UBYTE*)((ULONG)s_pBmDraw->Planes[0] + ulOffsBCD);
 	g_pCustom->bltdpt = (UBYTE*)((ULONG)s_pBmDraw->Planes[0] + ulOffsBCD);
 	g_pCustom->bltsize = ((uwHeight * GAME_BPP) << HSIZEBITS) | (uwBlitWidthInWords);
@@ -55,6 +66,29 @@ static void fixBackgroundEdges(void) {
 	UWORD uwBlitWidthInWords = 1;
 	WORD wModuloBCD = bitmapGetByteWidth(s_pBmDraw) - (uwBlitWidthInWords << 1);
 
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	// No pristine buffer - gather background beneath edges from tiles first,
+	// in the same order as edges are fixed below.
+	tUwCoordYX sOrigin = commGetOrigin();
+	gameRestoreBackground(
+		s_pBmEdgesBg, 0, 0, sOrigin.uwX, sOrigin.uwY, COMM_EDGE_WIDTH, 5
+	);
+	gameRestoreBackground(
+		s_pBmEdgesBg, 0, 5, sOrigin.uwX + COMM_WIDTH - 16, sOrigin.uwY,
+		COMM_EDGE_WIDTH, 4
+	);
+	gameRestoreBackground(
+		s_pBmEdgesBg, 0, 5 + 4, sOrigin.uwX, sOrigin.uwY + COMM_HEIGHT - 4,
+		COMM_EDGE_WIDTH, 4
+	);
+	gameRestoreBackground(
+		s_pBmEdgesBg, 0, 5 + 4 + 4,
+		sOrigin.uwX + COMM_WIDTH - 16, sOrigin.uwY + COMM_HEIGHT - 5,
+		COMM_EDGE_WIDTH, 5
+	);
+	s_pNextEdgeBg = s_pBmEdgesBg->Planes[0];
+#endif
+
 	blitWait();
 	g_pCustom->bltafwm = 0xFFFF;
 	g_pCustom->bltalwm = 0xFFFF;
@@ -63,7 +97,11 @@ static void fixBackgroundEdges(void) {
 
 	g_pCustom->bltapt = (UBYTE*)((ULONG)s_pBmEdgesMask->Planes[0]);
 	g_pCustom->bltamod = 0;
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	g_pCustom->bltbmod = wModuloBCD;
+#else
+	g_pCustom->bltbmod = bitmapGetByteWidth(s_pBmEdgesBg) - (uwBlitWidthInWords << 1);
+#endif
 	g_pCustom->bltcmod = wModuloBCD;
 	g_pCustom->bltdmod = wModuloBCD;
 
@@ -77,8 +115,13 @@ static void fixBackgroundEdges(void) {
 
 void commCreate(void) {
 	systemUse();
-	s_pBg = bitmapCreateFromPath("data/killfriend.bm", 0);
-	s_pBmEdgesMask = bitmapCreateFromPath("data/killfriend_edges.bm", 0);
+	s_pBg = assetArchiveBitmapCreate("killfriend.bm");
+	s_pBmEdgesMask = assetArchiveBitmapCreate("killfriend_edges.bm");
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	s_pBmEdgesBg = bitmapCreate(
+		COMM_EDGE_WIDTH, COMM_EDGE_BG_HEIGHT, GAME_BPP, BMF_INTERLEAVED
+	);
+#endif
 	systemUnuse();
 
 	s_isCommShown = 0;
@@ -89,6 +132,9 @@ void commDestroy(void) {
 
 	bitmapDestroy(s_pBg);
 	bitmapDestroy(s_pBmEdgesMask);
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	bitmapDestroy(s_pBmEdgesBg);
+#endif
 
 	bitmapDestroy(g_pCommBmFaces);
 	bitmapDestroy(g_pCommBmSelection);
@@ -99,6 +145,9 @@ void commDestroy(void) {
 
 void commShow(void) {
 	g_pGameBufferMain->pCamera->uPos.uwX &= 0xFFF0;
+#if defined(GAME_BG_RING_BUFFER)
+	gameBufferUnwrap();
+#endif
 	tUwCoordYX sOrigin = commGetOrigin();
 	s_isCommShown = 1;
 
@@ -124,11 +173,18 @@ void commHide(void) {
 
 	// Restore content beneath commrade
 	tUwCoordYX sOrigin = commGetOrigin();
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	blitCopyAligned(
 		g_pGamePristineBuffer, sOrigin.uwX, sOrigin.uwY,
 		s_pBmDraw, sOrigin.uwX, sOrigin.uwY,
 		COMM_WIDTH, COMM_HEIGHT
 	);
+#else
+	gameRestoreBackground(
+		s_pBmDraw, sOrigin.uwX, sOrigin.uwY,
+		sOrigin.uwX, sOrigin.uwY, COMM_WIDTH, COMM_HEIGHT
+	);
+#endif
 }
 
 UBYTE commIsShown(void) {
@@ -6,7 +6,6 @@
 #include <ace/managers/system.h>
 #include <ace/managers/key.h>
 #include <ace/managers/mouse.h>
-#include <ace/utils/disk_file.h>
 #include <ace/utils/palette.h>
 #include <ace/generic/screen.h>
 #include "fade.h"
@@ -15,6 +14,7 @@
 #include "game.h"
 #include "assets.h"
 #include "survivor.h"
+#include "asset_archive.h"
 
 #define SLIDES_MAX 10
 #define LINES_PER_SLIDE_MAX 6
@@ -172,11 +172,11 @@ static void cutsceneGsCreate(void) {
 
 	s_ubCurrentSlide = 0;
 	s_ubCurrentLine = 0;
-	s_pModIntro = ptplayerModCreateFromPath("data/intro.mod");
+	s_pModIntro = ptplayerModCreateFromFd(assetArchiveOpen("intro.mod", 0));
 
 	// Load palette
 	UWORD pPalette[32];
-	paletteLoadFromPath("data/intro.plt", pPalette, 32);
+	paletteLoadFromFd(assetArchiveOpen("intro.plt", 0), pPalette, 32);
 	s_pFade = fadeCreate(s_pView, pPalette, 32);
 
 	s_uwFontColorVal = pPalette[COLOR_TEXT];
@@ -202,13 +202,15 @@ static void cutsceneGsCreate(void) {
 	char szPath[30];
 	s_ubSlideCount = 0;
 	for(s_ubSlideCount = 0; s_ubSlideCount < 10; ++s_ubSlideCount) {
-		sprintf(szPath, "data/intro/%hhu.bm", s_ubSlideCount);
-		if(!diskFileExists(szPath)) {
+		sprintf(szPath, "intro/%hhu.bm", s_ubSlideCount);
+		if(!assetArchiveExists(szPath)) {
 			break;
 		}
-		s_pSlides[s_ubSlideCount].pBitmap = bitmapCreateFromPath(szPath, 0);
-		sprintf(szPath, "data/intro/%hhu.plt", s_ubSlideCount);
-		paletteLoadFromPath(szPath, s_pSlides[s_ubSlideCount].pPalette, 32);
+		s_pSlides[s_ubSlideCount].pBitmap = assetArchiveBitmapCreate(szPath);
+		sprintf(szPath, "intro/%hhu.plt", s_ubSlideCount);
+		paletteLoadFromFd(
+			assetArchiveOpen(szPath, 0), s_pSlides[s_ubSlideCount].pPalette, 32
+		);
 		s_pSlides[s_ubSlideCount].pPalette[COLOR_TEXT] = s_uwFontColorVal;
 	}
 
@@ -295,6 +297,7 @@ static void cutsceneLoopFinale(void) {
 }
 
 static void cutsceneGsLoop(void) {
+	assetArchivePrefetchProcess();
 	tFadeState eFadeState = fadeProcess(s_pFade);
 	if(s_pVp) {
 		vPortWaitForEnd(s_pVp);
@@ -3,12 +3,15 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "game.h"
+#include <exec/execbase.h>
+#include <proto/exec.h> // SysBase
 #include <ace/managers/bob.h>
 #include <ace/managers/key.h>
 #include <ace/managers/mouse.h>
 #include <ace/managers/system.h>
 #include <ace/managers/sprite.h>
 #include <ace/managers/ptplayer.h>
+#include <ace/managers/timer.h>
 #include <ace/contrib/managers/audio_mixer.h>
 #include <ace/utils/palette.h>
 #include <ace/utils/chunky.h>
@@ -20,8 +23,21 @@
 #include "menu.h"
 #include "hi_score.h"
 #include "pause.h"
-
-#define RELOAD_CLICK_COOLDOWN 4
+#include "sprite_mux.h"
+#include "blit_queue.h"
+#include "blit_hog.h"
+#include "game_rand.h"
+#include "sfx_queue.h"
+#include "sfx_sequence.h"
+#include "asset_archive.h"
+
+#define RELOAD_CLICK_GAP_MS (4 * 1000 / GAME_FPS)
+#define MIXER_PROFILE_FRAMES_MAX 0x8000
+#define MIXER_PROFILE_CLOCKS_PER_LINE 227
+// PAL, 50 vblanks per second
+#define MIXER_PROFILE_CLOCKS_PER_GAME_FRAME (\
+	(50 / GAME_FPS) * 313 * MIXER_PROFILE_CLOCKS_PER_LINE \
+)
 
 #define PERK_DEATH_CLOCK_COOLDOWN 5
 #define PERK_DODGE_CHANCE_DODGER 10
@@ -37,11 +53,20 @@
 #define WEAPON_MAX_BULLETS_IN_MAGAZINE (((30 + 2) * 12 + 5) / 10)
 #define STAIN_FRAME_COUNT 6
 #define STAIN_FRAME_PRESET_COUNT 16
-#define STAINS_MAX 20
+// Must fit stains pending after forced stamping plus hits from 2 frames.
+// Equal indices mean empty queue, so it holds one entry less than its size.
+#define STAIN_QUEUE_SIZE 64
+#define STAIN_QUEUE_MASK (STAIN_QUEUE_SIZE - 1)
+#define STAIN_QUEUE_FORCE_THRESHOLD (STAIN_QUEUE_SIZE - 2 * PROJECTILE_COUNT - 1)
+// Bytes written by stain blits & decal captures in a frame, unless queue
+// gets too full.
+#define STAIN_BYTES_PER_FRAME 2048
 #define STAIN_SIZE_X 16
 #define STAIN_SIZE_Y 16
 #define STAIN_BYTES_PER_BITPLANE_ROW (STAIN_SIZE_X / 8)
 #define STAIN_BYTES_PER_PIXEL_ROW (STAIN_BYTES_PER_BITPLANE_ROW * GAME_BPP)
+// Destination area of a single stain blit, including the shift word.
+#define STAIN_BLIT_BYTES ((STAIN_BYTES_PER_BITPLANE_ROW + 2) * STAIN_SIZE_Y * GAME_BPP)
 
 #define DIGIT_WIDTH_MAX 5
 #define HUD_WEAPON_SIZE_X 48
@@ -69,6 +94,9 @@
 #define HUD_SCORE_NUMBER_Y 2
 #define HUD_SCORE_NUMBER_SIZE_X (HUD_SCORE_DIGITS * (DIGIT_WIDTH_MAX + 1) - 1)
 #define HUD_SCORE_NUMBER_SIZE_Y 5
+#define HUD_SCORE_DIGIT_CELL_X (DIGIT_WIDTH_MAX + 1)
+#define HUD_SCORE_DIGIT_BLANK 10
+#define HUD_SCORE_DIGIT_REDRAW 0xFF
 #define HUD_SCORE_BAR_OFFSET_X 215
 #define HUD_SCORE_BAR_OFFSET_Y 8
 #define HUD_SCORE_BAR_SIZE_X 100
@@ -83,28 +111,56 @@
 // #define BULLET_OFFSET_Y_BULLET 6
 
 #define SFX_CHANNEL_SHOOT 0
-#define SFX_PRIORITY_SHOOT 0
+#define SFX_PRIORITY_SHOOT 1
 #define SFX_CHANNEL_RELOAD 0
-#define SFX_PRIORITY_RELOAD 1
+#define SFX_PRIORITY_RELOAD 2
 #define SFX_CHANNEL_BITE 2
-#define SFX_PRIORITY_BITE 0
+#define SFX_PRIORITY_BITE 4
 #define SFX_CHANNEL_IMPACT 1
 #define SFX_PRIORITY_IMPACT 0
 #define SFX_CHANNEL_EXPLOSION 0
-#define SFX_PRIORITY_EXPLOSION 2
+#define SFX_PRIORITY_EXPLOSION 3
 #define SFX_CHANNEL_DEATH 1
-#define SFX_PRIORITY_DEATH 1
+#define SFX_PRIORITY_DEATH 5
 
-#define MAP_TILES_X 32
-#define MAP_TILES_Y 32
-#define MAP_MARGIN_TILES 2
-#define MAP_TILE_SHIFT 4
-#define MAP_TILE_SIZE (1 << MAP_TILE_SHIFT)
 #define BG_TILE_SHIFT 5
 #define BG_TILE_SIZE (1 << BG_TILE_SHIFT)
 #define BG_TILES_X (MAP_TILES_X * MAP_TILE_SIZE / BG_TILE_SIZE)
 #define BG_TILES_Y (MAP_TILES_Y * MAP_TILE_SIZE / BG_TILE_SIZE)
+_Static_assert(
+	BG_TILE_SIZE == 32, "Map composing expects bg tiles to be longword wide"
+);
+
+// Projectile positions are 26.6 fixed point & entities use UWORD coords, so
+// map size is bound by UBYTE map & bg tile coords.
+_Static_assert(
+	MAP_TILES_X <= 0xFF && MAP_TILES_Y <= 0xFF &&
+	!((MAP_TILES_Y * MAP_TILE_SIZE) & (BG_TILE_SIZE - 1)),
+	"Map must fit UBYTE tile coords & be made of whole bg tiles"
+);
+
+#if defined(GAME_BG_RING_BUFFER)
+#if defined(ACE_BOB_PRISTINE_BUFFER) || defined(GAME_MAP_GENERATE_PER_TILE)
+#error "GAME_BG_RING_BUFFER needs background restored from tiles & batched map draw"
+#endif
+#define BG_RING_TILE_NONE 0xFF
+// Rows filled ahead of camera, enemies further away are despawned anyway.
+#define BG_RING_MARGIN_Y BG_TILE_SIZE
+// bplcon0 (set by game), bplcon1, ddfstrt, ddfstop, 2x modulo, bitplane ptrs
+#define BG_RING_COP_BREAK_POS (6 + 2 * GAME_BPP)
+// 2 waits to get past line 255, bitplane ptrs
+#define BG_RING_COP_CMD_COUNT (BG_RING_COP_BREAK_POS + 2 + 2 * GAME_BPP)
+_Static_assert(
+	!(BG_RING_SIZE_Y & (BG_TILE_SIZE - 1)) &&
+	BG_RING_SIZE_Y >= GAME_MAIN_VPORT_SIZE_Y + 2 * BG_RING_MARGIN_Y + BG_TILE_SIZE,
+	"Ring buffer must fit view with margins around it & wrap on bg tile edge"
+);
+#define BG_BUFFER_Y(uwY) ((uwY) % BG_RING_SIZE_Y)
+#else
+#define BG_BUFFER_Y(uwY) (uwY)
+#endif
 #define SPRITE_CHANNEL_CURSOR 4
+#define SPRITE_RAW_COP_POS 0
 
 #define COLOR_FRAME_HURT 23
 #define COLOR_FRAME_LEVEL 27
@@ -115,12 +171,6 @@
 #define COLOR_HUD_LABEL 9
 #define COLOR_HUD_DIGITS 3
 
-#define COLLISION_SIZE_X 8
-#define COLLISION_SIZE_Y 8
-#define COLLISION_LOOKUP_SIZE_X (MAP_TILES_X * MAP_TILE_SIZE / COLLISION_SIZE_X)
-#define COLLISION_LOOKUP_SIZE_Y (MAP_TILES_Y * MAP_TILE_SIZE / COLLISION_SIZE_Y)
-#define RESPAWN_SLOTS_PER_POSITION 4
-
 #define HEALTH_ENEMY_DEAD_AWAITING_RESPAWN (-32768)
 #define HEALTH_ENEMY_OFFSCREENED (-32767)
 #define HEALTH_ENEMY_DEATH_ANIM (-32764)
@@ -129,6 +179,7 @@
 
 #define PLAYER_BOB_SIZE_X 32
 #define PLAYER_BOB_SIZE_Y 32
+#define PLAYER_BOB_BYTES_PER_PIXEL_ROW ((PLAYER_BOB_SIZE_X / 8) * GAME_BPP)
 // From the top-left of the collision rectangle
 #define PLAYER_BOB_OFFSET_X 12
 #define PLAYER_BOB_OFFSET_Y 19
@@ -137,8 +188,6 @@
 #define PLAYER_HEALTH_MAX 100
 #define PLAYER_RETALIATION_DAMAGE 30
 
-#define ENEMY_BOB_SIZE_X 16
-#define ENEMY_BOB_SIZE_Y 24
 // From the top-left of the collision rectangle
 #define ENEMY_BOB_OFFSET_X 4
 #define ENEMY_BOB_OFFSET_Y 15
@@ -147,16 +196,22 @@
 #define ENEMY_DAMAGE_BASE 5
 #define ENEMY_HEALTH_ADD_PER_LEVEL 5
 #define ENEMY_EXP 25
+#define ENEMY_EXP_BCD 0x25
 #define ENEMY_EXP_HI_SPEED 40
+#define ENEMY_EXP_HI_SPEED_BCD 0x40
 #define ENEMY_SPEEDY_CHANCE_MAX 127
 #define ENEMY_SPEEDY_CHANCE_ADD_PER_LEVEL 20
 #define ENEMY_PREFERRED_SPAWN_NONE 0xFF
 
 #define ENEMY_COUNT 25
 #define PROJECTILE_COUNT 20
+_Static_assert(
+	STAIN_QUEUE_FORCE_THRESHOLD > 0 && !(STAIN_QUEUE_SIZE & STAIN_QUEUE_MASK),
+	"Stain queue must be power of 2, its usable SIZE - 1 entries fitting"
+	" forced-stamp threshold plus hits of all projectiles twice"
+);
 #define PROJECTILE_LIFETIME GAME_FPS
 #define PROJECTILE_SPEED 5
-#define SPREAD_SIDE_COUNT 40
 
 #define PICKUP_BOB_SIZE_X 16
 #define PICKUP_BOB_SIZE_Y 12
@@ -169,14 +224,27 @@
 // + player + pickup
 #define SORTED_ENTITIES_COUNT (ENEMY_COUNT + 1 + 1)
 
-#define BG_BYTES_PER_BITPLANE_ROW (MAP_TILES_X * MAP_TILE_SIZE / 8)
-#define BG_BYTES_PER_PIXEL_ROW (BG_BYTES_PER_BITPLANE_ROW * GAME_BPP)
+// Camera may still move by a couple of pixels after bob got pushed, since
+// it's updated when player is processed among sorted entities.
+#define BOB_CULL_MARGIN 4
+#if defined(GAME_BG_RING_BUFFER)
+// Partially visible bobs stick out of view by up to their height & their
+// rows mustn't wrap into view.
+_Static_assert(
+	BG_RING_SIZE_Y >= GAME_MAIN_VPORT_SIZE_Y + 2 * (EXPLOSION_BOB_SIZE_Y + BOB_CULL_MARGIN),
+	"Bobs around view don't fit in ring buffer"
+);
+#endif
+
+// Tileset & decals are interleaved, tiles stacked vertically.
+#define BG_TILE_BYTES_PER_BITPLANE_ROW (BG_TILE_SIZE / 8)
+#define BG_TILE_BYTES_PER_PIXEL_ROW (BG_TILE_BYTES_PER_BITPLANE_ROW * GAME_BPP)
+#define BG_DECAL_TILES_MAX 48
+#define BG_DECAL_NONE 0xFF
 
 #define CURSOR_SPRITE_SIZE_X 16
 #define CURSOR_SPRITE_SIZE_Y (CURSOR_SIZE+2)
 
-typedef UWORD tFix10p6;
-
 typedef enum tBlinkKind {
 	BLINK_KIND_HURT,
 	BLINK_KIND_LEVEL,
@@ -249,9 +317,15 @@ typedef enum tWeaponKind {
 	WEAPON_KIND_SAWOFF,
 } tWeaponKind;
 
+/**
+ * @brief Bob frame with fully transparent top and bottom rows cut off.
+ * Pixel & mask pointers point at first non-empty row.
+ */
 typedef struct tFrameOffset {
 	UBYTE *pPixels;
 	UBYTE *pMask;
+	UBYTE ubTrimTop;
+	UBYTE ubTrimHeight;
 } tFrameOffset;
 
 typedef enum tEntityKind {
@@ -265,6 +339,8 @@ typedef struct tEntity {
 	tUwCoordYX sPos; ///< Top-left coordinate of collision box.
 	tBob sBob;
 	tCharacterFrame eFrame;
+	UBYTE ubBobTrimTop; ///< Trim of currently set bob frame.
+	UBYTE pBobDrawnHeights[2]; ///< Bob height drawn on each buffer.
 	WORD wHealth;
 	union {
 		struct {
@@ -285,6 +361,7 @@ typedef struct tEntity {
 			UBYTE ubSpeed;
 			UBYTE ubPreferredSpawn;
 			UWORD uwExp;
+			UWORD uwExpBcd;
 		} sEnemy;
 		struct {
 			tPickupKind ePickupKind;
@@ -294,23 +371,34 @@ typedef struct tEntity {
 	};
 } tEntity;
 
+// Projectile position, wide enough for any map height
+typedef ULONG tFix26p6;
+
 typedef struct tProjectile {
-	tFix10p6 fX;
-	tFix10p6 fY;
+	tFix26p6 fX;
+	tFix26p6 fY;
 	tFix10p6 fDx;
 	tFix10p6 fDy;
 	ULONG pPrevOffsets[2];
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	UBYTE **pPrevBgTiles[2]; ///< Entry of s_pBgTilePlanes beneath projectile.
+	UWORD pPrevBgTileOffsets[2];
+#endif
 	UBYTE ubLife;
 	UBYTE ubDamage;
 } tProjectile;
 
+typedef struct tStain {
+	UWORD uwX;
+	UWORD uwY;
+	const tFrameOffset *pFrame; ///< Zero if stain was skipped.
+} tStain;
+
 typedef enum tHudState {
 	HUD_STATE_DRAW_LEVEL_UP,
 	HUD_STATE_DRAW_HEALTH_BAR,
 	HUD_STATE_DRAW_WEAPON,
 	HUD_STATE_DRAW_BULLETS,
-	HUD_STATE_PREPARE_EXP_POINTS,
-	HUD_STATE_PREPARE_EXP_POINTS_TBM,
 	HUD_STATE_DRAW_EXP_POINTS,
 	HUD_STATE_DRAW_EXP_BAR,
 	HUD_STATE_PREPARE_LEVEL_NUM,
@@ -328,16 +416,42 @@ typedef enum tCursorKind {
 static tView *s_pView;
 static tVPort *s_pVpMain;
 static tVPort *s_pVpHud;
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 static UBYTE *s_pPristinePlanes;
+#endif
 static UBYTE *s_pBackPlanes;
 static tSimpleBufferManager *s_pBufferHud;
 static tBitMap *s_pTileset;
+static UBYTE s_pBgTileMap[BG_TILES_X][BG_TILES_Y]; ///< Tileset index of each bg tile.
+#if !defined(GAME_BG_RING_BUFFER) && !defined(GAME_MAP_GENERATE_PER_TILE)
+static UBYTE s_isMapComposedByCpu; ///< 68020+ composes map faster than blitter.
+#endif
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+// Without pristine buffer, clean background is recomposited from tileset.
+// Tiles with stains on them are copied to decal tiles & used from there.
+static tBitMap *s_pBgDecals;
+static UBYTE s_pBgDecalMap[BG_TILES_X][BG_TILES_Y]; ///< Decal index of each bg tile.
+static UBYTE s_ubBgDecalCount;
+static UBYTE s_ubBgDecalNext; ///< Oldest decal, recycled once all are used.
+static tUbCoordYX s_pBgDecalTiles[BG_DECAL_TILES_MAX]; ///< Bg tile of each decal.
+// Bg tiles whose decals got recycled, still stained on the other buffer.
+static tUbCoordYX s_pBgTilesRecycled[BG_DECAL_TILES_MAX];
+static UBYTE s_ubBgTilesRecycledCount;
+static UBYTE *s_pBgTilePlanes[BG_TILES_X][BG_TILES_Y]; ///< Clean bg tile data.
+#endif
+#if defined(GAME_BG_RING_BUFFER)
+static UWORD s_uwBgRowsTop; ///< First map row held by back buffer.
+static UWORD s_uwBgRowsHeight; ///< Number of map rows held by back buffer.
+static UBYTE s_isBufferUnwrapped;
+static UWORD s_uwBufferUnwrapY; ///< Map camera Y to be restored on resume.
+#endif
 static ULONG *s_pCursorData;
 static tBitMap *s_pBmCursor;
 static tBitMap *s_pBmCursorFrames;
 static ULONG *s_pCursorOffsets[CURSOR_KIND_COUNT];
 static tBitMap *s_pHudWeapons;
 static tBitMap *s_pHudLevelUp;
+static tBitMap *s_pBmHudDigits; ///< Pre-rendered digit cells & blank one.
 static tSprite *s_pSpriteCursor;
 static volatile ULONG s_ulFrameCount;
 static ULONG s_ulFrameWaitCount;
@@ -347,9 +461,12 @@ static tBitMap *s_pPlayerFrames[DIRECTION_COUNT];
 static tBitMap *s_pPlayerMasks[DIRECTION_COUNT];
 static tBitMap *s_pPlayerBlinkBitmaps[BLINK_KIND_COUNT];
 static UBYTE *s_pPlayerBlinkData[BLINK_KIND_COUNT];
+static tBlinkKind s_ePlayerBlinkKind;
 static tFrameOffset s_pPlayerFrameOffsets[DIRECTION_COUNT][ENTITY_FRAME_COUNT];
 static tEntity s_sPlayer;
 static ULONG s_ulScore;
+static UBYTE s_pScoreBcd[HUD_SCORE_DIGITS]; ///< Score digits, least significant first.
+static UBYTE s_ubScoreBcdLength;
 static UBYTE s_ubPendingPerks;
 static ULONG s_ulKills;
 static ULONG s_ulPrevLevelScore;
@@ -359,9 +476,11 @@ static UBYTE s_ubHiSpeedChance;
 static UWORD s_uwEnemySpawnHealth;
 static UBYTE s_ubEnemyDamage;
 static UBYTE s_isFinalReloadSfxPlayed;
-static UBYTE s_ubReloadClickCooldown;
 static UBYTE s_ubReloadFinalLength;
-static UBYTE s_ubReloadClickIndex;
+static tSfxSequenceStep s_pReloadClickSteps[2];
+static const tSfxSequence s_sReloadClickSequence = {
+	.pSteps = s_pReloadClickSteps, .ubStepCount = 2, .isLoop = 1
+};
 
 // Perks
 static UBYTE s_isDeathClock;
@@ -390,6 +509,8 @@ static tEntity s_sPickup;
 static tBitMap *s_pPickupFrames;
 static tBitMap *s_pPickupMasks;
 static tFrameOffset s_pPickupFrameOffsets[PICKUP_KIND_COUNT];
+static tSpriteMuxFrame s_pPickupSpriteFrames[PICKUP_KIND_COUNT];
+static UBYTE s_isPickupDrawPending;
 
 static tEntity *s_pSortedEntities[SORTED_ENTITIES_COUNT];
 
@@ -400,6 +521,8 @@ static tBitMap *s_pExplosionFrames;
 static tBitMap *s_pExplosionMasks;
 static tFrameOffset s_pExplosionFrameOffsets[EXPLOSION_FRAME_COUNT];
 static UBYTE s_ubExplosionFrame;
+static UBYTE s_ubExplosionTrimTop;
+static UBYTE s_pExplosionDrawnHeights[2];
 static UBYTE s_ubExplosionCooldown;
 
 static tBitMap *s_pStainFrames;
@@ -409,7 +532,6 @@ static tFrameOffset *s_pNextStainOffset;
 
 static UBYTE s_ubBufferCurr;
 static tProjectile *s_pCurrentProjectile;
-static tFix10p6 s_pSin10p6[GAME_MATH_ANGLE_COUNT];
 static UBYTE s_ubDeathCooldown;
 
 static const UBYTE s_pBulletMaskFromX[] = {
@@ -449,36 +571,47 @@ typedef struct tHudBulletDef {
 	UBYTE ubMaxDrawDelta;
 } tHudBulletDef;
 
-static ULONG s_pRowOffsetFromY[MAP_TILES_Y * MAP_TILE_SIZE];
-
 static tEntity *s_pCollisionTiles[COLLISION_LOOKUP_SIZE_X][COLLISION_LOOKUP_SIZE_Y];
-static tUwCoordYX s_pRespawnSlots[COLLISION_LOOKUP_SIZE_X][COLLISION_LOOKUP_SIZE_Y][RESPAWN_SLOTS_PER_POSITION]; // left, right, up, down
 
 static tProjectile s_pProjectiles[PROJECTILE_COUNT];
 static tProjectile *s_pFreeProjectiles[PROJECTILE_COUNT];
 static UBYTE s_ubFreeProjectileCount;
-static BYTE s_pSpreadSide1[SPREAD_SIDE_COUNT];
-static BYTE s_pSpreadSide2[SPREAD_SIDE_COUNT];
-static BYTE s_pSpreadSide3[SPREAD_SIDE_COUNT];
-static BYTE s_pSpreadSide10[SPREAD_SIDE_COUNT];
 
 static tHudState s_eHudState;
 static UWORD s_uwHudHealth;
 static UBYTE s_ubHudAmmoCount;
-static ULONG s_ulHudScore;
+static UBYTE s_pHudScoreDigits[HUD_SCORE_DIGITS]; ///< Drawn cells, from left.
 static ULONG s_ubHudBarPixel;
 static UBYTE s_ubHudLevel;
 static UBYTE s_ubHudPendingPerksDrawn;
 static tHudBulletDef s_pHudBulletDefs[WEAPON_MAX_BULLETS_IN_MAGAZINE];
 
 static tBob s_sExplosionBob;
-static tBob s_pStainBobs[STAINS_MAX];
-static tBob *s_pFreeStains[STAINS_MAX];
-static tBob *s_pPushStains[STAINS_MAX];
-static tBob *s_pWaitStains[STAINS_MAX];
-static tBob **s_pNextFreeStain;
-static tBob **s_pNextPushStain;
-static tBob **s_pNextWaitStain;
+// Stains are stamped permanently into the background. Queue entries go from
+// pending to stamped on one buffer (and pristine) to stamped on both.
+static tStain s_pStains[STAIN_QUEUE_SIZE];
+static UBYTE s_ubStainStamped; ///< Oldest stain stamped only on one buffer.
+static UBYTE s_ubStainPending; ///< Oldest stain not stamped yet.
+static UBYTE s_ubStainFree; ///< Next free queue entry.
+#if defined(GAME_DEBUG)
+static UBYTE s_ubStainsPendingMax;
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+static ULONG s_ulBgDecalsRecycled;
+#endif
+static ULONG s_ulPlayfieldChipBytes; ///< Measured, incl. bob bg saves.
+#endif
+static UWORD s_uwBobsCulled;
+#if defined(GAME_DEBUG)
+static UWORD s_uwBobsCulledMax;
+static ULONG s_ulBobsCulledTotal;
+#endif
+#if defined(MIXER_COUNTER)
+static UWORD s_uwMixerFrames;
+static ULONG s_ulMixerInterrupts;
+static ULONG s_ulMixerClocks;
+static ULONG s_ulMixerFrameClocksMax;
+static ULONG s_ulMixerIrqClocksMax;
+#endif
 
 static const tBCoordYX s_pPlayerFrameDeathOffset[DIRECTION_COUNT][8] = {
 	[DIRECTION_S] = {
@@ -543,16 +676,21 @@ static const tBCoordYX s_pPlayerFrameDeathOffset[DIRECTION_COUNT][8] = {
 	},
 };
 
+#if defined(GAME_BG_RING_BUFFER)
+tGameRingBuffer *g_pGameBufferMain;
+#else
 tSimpleBufferManager *g_pGameBufferMain;
+#endif
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 tBitMap *g_pGamePristineBuffer;
-tRandManager g_sRand;
+#endif
 
 //------------------------------------------------------------------ PRIVATE FNS
 
-static inline tFix10p6 fix10p6Add(tFix10p6 a, tFix10p6 b) {return a + b; }
-static inline tFix10p6 fix10p6FromUword(UWORD x) {return x << 6; }
-static inline tFix10p6 fix10p6ToUword(UWORD x) {return x >> 6; }
-#define fix10p6Sin(x) s_pSin10p6[x]
+static inline tFix26p6 fix26p6Add(tFix26p6 a, tFix10p6 b) {return a + b; }
+static inline tFix26p6 fix26p6FromUword(UWORD x) {return (ULONG)x << 6; }
+static inline ULONG fix26p6ToUlong(tFix26p6 x) {return x >> 6; }
+#define fix10p6Sin(x) g_pSin10p6[x]
 #define fix10p6Cos(x) (((x) < 3 * ANGLE_90) ? fix10p6Sin(ANGLE_90 + (x)) : fix10p6Sin((x) - (3 * ANGLE_90)))
 
 __attribute__((always_inline))
@@ -564,9 +702,191 @@ static inline void gameSetCursor(tCursorKind eKind) {
 	}
 }
 
+static UBYTE isBitmapRowEmpty(const tBitMap *pBitmap, UWORD uwY) {
+	const UBYTE *pRow = &pBitmap->Planes[0][uwY * pBitmap->BytesPerRow];
+	for(UWORD uwByte = bitmapGetByteWidth(pBitmap); uwByte--;) {
+		if(pRow[uwByte]) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void frameOffsetInit(
+	tFrameOffset *pOffset, tBitMap *pFrames, tBitMap *pMasks,
+	UWORD uwFrameY, UBYTE ubHeight
+) {
+	UBYTE ubTop = 0;
+	UBYTE ubBottom = ubHeight;
+	while(ubTop < ubBottom && isBitmapRowEmpty(pMasks, uwFrameY + ubTop)) {
+		++ubTop;
+	}
+	while(ubBottom > ubTop && isBitmapRowEmpty(pMasks, uwFrameY + ubBottom - 1)) {
+		--ubBottom;
+	}
+	if(ubTop == ubBottom) {
+		// Fully transparent frame - keep a single row so that bob is still valid
+		ubTop = 0;
+		ubBottom = 1;
+	}
+
+	pOffset->pPixels = bobCalcFrameAddress(pFrames, uwFrameY + ubTop);
+	pOffset->pMask = bobCalcFrameAddress(pMasks, uwFrameY + ubTop);
+	pOffset->ubTrimTop = ubTop;
+	pOffset->ubTrimHeight = ubBottom - ubTop;
+}
+
+/**
+ * @brief Sets trimmed frame on bob placed at untrimmed position.
+ */
+__attribute__((always_inline))
+static inline void bobSetFrameTrimmed(
+	tBob *pBob, UBYTE *pTrimTop, const tFrameOffset *pOffset, UWORD uwX, UWORD uwY
+) {
+	bobSetFrame(pBob, pOffset->pPixels, pOffset->pMask);
+	bobSetHeight(pBob, pOffset->ubTrimHeight);
+	pBob->sPos.uwX = uwX;
+	pBob->sPos.uwY = uwY + pOffset->ubTrimTop;
+	*pTrimTop = pOffset->ubTrimTop;
+}
+
+/**
+ * @brief Sets trimmed frame on bob, keeping its current untrimmed position.
+ */
+__attribute__((always_inline))
+static inline void bobChangeFrameTrimmed(
+	tBob *pBob, UBYTE *pTrimTop, const tFrameOffset *pOffset
+) {
+	bobSetFrame(pBob, pOffset->pPixels, pOffset->pMask);
+	bobSetHeight(pBob, pOffset->ubTrimHeight);
+	pBob->sPos.uwY += pOffset->ubTrimTop - *pTrimTop;
+	*pTrimTop = pOffset->ubTrimTop;
+}
+
+/**
+ * @brief Swaps bob's current height with the one drawn on current buffer.
+ *
+ * Bob manager undraws with bob's current height, but trimmed frames may have
+ * changed it since that buffer was drawn two frames ago. Called around
+ * bobBegin() - first to undraw with drawn height, then to bring back the
+ * current one.
+ */
+__attribute__((always_inline))
+static inline void bobSwapDrawnHeight(tBob *pBob, UBYTE *pDrawnHeights) {
+	UBYTE ubHeight = pBob->uwHeight;
+	bobSetHeight(pBob, pDrawnHeights[s_ubBufferCurr]);
+	pDrawnHeights[s_ubBufferCurr] = ubHeight;
+}
+
+static void bobsSwapDrawnHeights(void) {
+	for(UBYTE i = 0; i < SORTED_ENTITIES_COUNT; ++i) {
+		tEntity *pEntity = s_pSortedEntities[i];
+		bobSwapDrawnHeight(&pEntity->sBob, pEntity->pBobDrawnHeights);
+	}
+	bobSwapDrawnHeight(&s_sExplosionBob, s_pExplosionDrawnHeights);
+}
+
+static void bobsSaveDrawnHeights(void) {
+	for(UBYTE i = 0; i < SORTED_ENTITIES_COUNT; ++i) {
+		tEntity *pEntity = s_pSortedEntities[i];
+		pEntity->pBobDrawnHeights[s_ubBufferCurr] = pEntity->sBob.uwHeight;
+	}
+	s_pExplosionDrawnHeights[s_ubBufferCurr] = s_sExplosionBob.uwHeight;
+}
+
+#if defined(GAME_SINGLE_PLANE_STAIN_MASKS)
+/**
+ * @brief Replaces interleaved mask, which has same data on each plane,
+ * with its single-plane copy. Used only for stain masks, which are blitted
+ * by blitUnsafeCopyStainPart() plane by plane.
+ */
+static tBitMap *maskCreateSinglePlane(tBitMap *pMask) {
+	UWORD uwByteWidth = bitmapGetByteWidth(pMask);
+	tBitMap *pSinglePlane = bitmapCreate(
+		uwByteWidth * 8, pMask->Rows, 1, 0
+	);
+	for(UWORD uwY = 0; uwY < pMask->Rows; ++uwY) {
+		memcpy(
+			&pSinglePlane->Planes[0][uwY * pSinglePlane->BytesPerRow],
+			&pMask->Planes[0][uwY * pMask->BytesPerRow], uwByteWidth
+		);
+	}
+	logWrite(
+		"Single-plane mask: %hux%hu, saved %lu bytes of chip\n",
+		uwByteWidth * 8, pMask->Rows,
+		(ULONG)(pMask->BytesPerRow - pSinglePlane->BytesPerRow) * pMask->Rows
+	);
+	bitmapDestroy(pMask);
+	return pSinglePlane;
+}
+#endif
+
+/**
+ * @brief Loads bob mask, which asset archive stores as a single plane, and
+ * repeats it on each plane of interleaved bitmap with given depth, as needed
+ * for blitting it along with interleaved frames. Masks which already have
+ * given depth, e.g. loose ones read from disk, are returned as they are.
+ */
+static tBitMap *maskCreate(const char *szName, UBYTE ubDepth) {
+	tBitMap *pMask = assetArchiveBitmapCreate(szName);
+	if(pMask->Depth == ubDepth) {
+		return pMask;
+	}
+#if defined(GAME_SINGLE_PLANE_STAIN_MASKS)
+	if(ubDepth == 1) {
+		return maskCreateSinglePlane(pMask);
+	}
+#endif
+
+	UWORD uwRowWords = pMask->BytesPerRow / sizeof(UWORD);
+	tBitMap *pExpanded = bitmapCreate(
+		pMask->BytesPerRow * 8, pMask->Rows, ubDepth, BMF_INTERLEAVED
+	);
+	const UWORD *pSrc = (const UWORD*)pMask->Planes[0];
+	UWORD *pDst = (UWORD*)pExpanded->Planes[0];
+	for(UWORD uwY = 0; uwY < pMask->Rows; ++uwY) {
+		for(UBYTE ubPlane = 0; ubPlane < ubDepth; ++ubPlane) {
+			for(UWORD uwX = 0; uwX < uwRowWords; ++uwX) {
+				*(pDst++) = pSrc[uwX];
+			}
+		}
+		pSrc += uwRowWords;
+	}
+	bitmapDestroy(pMask);
+	return pExpanded;
+}
+
+/**
+ * @brief Pushes bob only if it's at least partially visible on camera.
+ * Bobs which are not pushed are still undrawn from their previous positions
+ * by the bob manager, so there's no need to track them.
+ */
+__attribute__((always_inline))
+static inline void bobPushCulled(tBob *pBob) {
+	const tUwCoordYX *pCamPos = &g_pGameBufferMain->pCamera->uPos;
+	if(
+		pBob->sPos.uwX + pBob->uwWidth + BOB_CULL_MARGIN <= pCamPos->uwX ||
+		pCamPos->uwX + GAME_MAIN_VPORT_SIZE_X + BOB_CULL_MARGIN <= pBob->sPos.uwX ||
+		pBob->sPos.uwY + pBob->uwHeight + BOB_CULL_MARGIN <= pCamPos->uwY ||
+		pCamPos->uwY + GAME_MAIN_VPORT_SIZE_Y + BOB_CULL_MARGIN <= pBob->sPos.uwY
+	) {
+		++s_uwBobsCulled;
+		return;
+	}
+	bobPush(pBob);
+}
+
+__attribute__((always_inline))
+static inline UBYTE *playerGetBlinkData(void) {
+	return &s_pPlayerBlinkData[s_ePlayerBlinkKind][
+		s_sPlayer.ubBobTrimTop * PLAYER_BOB_BYTES_PER_PIXEL_ROW
+	];
+}
+
 __attribute__((always_inline))
 static inline void playerSetBlink(tBlinkKind eBlinkKind) {
-	s_sPlayer.sBob.pFrameData = s_pPlayerBlinkData[eBlinkKind];
+	s_ePlayerBlinkKind = eBlinkKind;
+	s_sPlayer.sBob.pFrameData = playerGetBlinkData();
 	s_sPlayer.sPlayer.ubBlinkCooldown = PLAYER_BLINK_COOLDOWN;
 }
 
@@ -584,23 +904,72 @@ static inline void scoreLevelUp(void) {
 	playerSetBlink(BLINK_KIND_LEVEL);
 }
 
+// Kept alongside binary score so that HUD doesn't need to convert it.
+// Value is packed BCD, so it's added nibble by nibble without any division.
+static void scoreBcdAdd(ULONG ulBcd) {
+	UBYTE ubCarry = 0;
+	for(UBYTE i = 0; i < HUD_SCORE_DIGITS && (ulBcd || ubCarry); ++i) {
+		UBYTE ubDigit = s_pScoreBcd[i] + ubCarry + (ulBcd & 0xF);
+		ulBcd >>= 4;
+		ubCarry = (ubDigit >= 10);
+		if(ubCarry) {
+			ubDigit -= 10;
+		}
+		s_pScoreBcd[i] = ubDigit;
+		if(ubDigit && i >= s_ubScoreBcdLength) {
+			s_ubScoreBcdLength = i + 1;
+		}
+	}
+}
+
+// Only for scores computed at runtime - fixed ones are given in BCD already.
+static ULONG scoreBcdFromULong(ULONG ulValue) {
+	ULONG ulBcd = 0;
+	for(UBYTE i = 0; i < sizeof(ulBcd) * 2 && ulValue; ++i) {
+		ulBcd |= (ulValue % 10) << (i * 4);
+		ulValue /= 10;
+	}
+	return ulBcd;
+}
+
+static void scoreBcdReset(void) {
+	for(UBYTE i = 0; i < HUD_SCORE_DIGITS; ++i) {
+		s_pScoreBcd[i] = 0;
+	}
+	s_ubScoreBcdLength = 1;
+}
+
 __attribute__((always_inline))
-static inline void scoreAddSmall(ULONG ulScore) {
+static inline void scoreAddSmall(ULONG ulScore, ULONG ulScoreBcd) {
 	s_ulScore += ulScore;
+	scoreBcdAdd(ulScoreBcd);
 	if(s_ulScore >= s_ulNextLevelScore) {
 		scoreLevelUp();
 	}
 }
 
 // Can add multiple levels at once
-static void scoreAddLarge(ULONG ulScore) {
+static void scoreAddLarge(ULONG ulScore, ULONG ulScoreBcd) {
 	s_ulScore += ulScore;
+	scoreBcdAdd(ulScoreBcd);
 	while(s_ulScore >= s_ulNextLevelScore) {
 		scoreLevelUp();
 	}
 }
 
+static void gameSetTileIndex(UBYTE ubTileIndex, UWORD uwBgTileX, UWORD uwBgTileY) {
+	s_pBgTileMap[uwBgTileX][uwBgTileY] = ubTileIndex;
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	s_pBgDecalMap[uwBgTileX][uwBgTileY] = BG_DECAL_NONE;
+	s_pBgTilePlanes[uwBgTileX][uwBgTileY] = &s_pTileset->Planes[0][
+		ubTileIndex * BG_TILE_SIZE * s_pTileset->BytesPerRow
+	];
+#endif
+}
+
+#if defined(GAME_MAP_GENERATE_PER_TILE)
 static void gameSetTile(UBYTE ubTileIndex, UWORD uwBgTileX, UWORD uwBgTileY) {
+	gameSetTileIndex(ubTileIndex, uwBgTileX, uwBgTileY);
 	blitCopyAligned(
 		s_pTileset, 0, ubTileIndex * BG_TILE_SIZE,
 		g_pGameBufferMain->pBack, uwBgTileX * BG_TILE_SIZE, uwBgTileY * BG_TILE_SIZE,
@@ -611,13 +980,422 @@ static void gameSetTile(UBYTE ubTileIndex, UWORD uwBgTileX, UWORD uwBgTileY) {
 		g_pGameBufferMain->pFront, uwBgTileX * BG_TILE_SIZE, uwBgTileY * BG_TILE_SIZE,
 		BG_TILE_SIZE, BG_TILE_SIZE
 	);
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	blitCopyAligned(
 		s_pTileset, 0, ubTileIndex * BG_TILE_SIZE,
 		g_pGamePristineBuffer, uwBgTileX * BG_TILE_SIZE, uwBgTileY * BG_TILE_SIZE,
 		BG_TILE_SIZE, BG_TILE_SIZE
 	);
+#endif
+}
+#else
+#if !defined(GAME_BG_RING_BUFFER)
+// Composes whole map from tile indices into given buffer. All tile blits
+// share the same setup, so only pointers & size are written for each tile.
+// Used on 68000, which moves data slower than the blitter.
+static void gameDrawMap(tBitMap *pDst) {
+	UWORD uwBltSize = ((BG_TILE_SIZE * GAME_BPP) << HSIZEBITS) | (BG_TILE_SIZE / 16);
+	UBYTE *pTiles = s_pTileset->Planes[0];
+	ULONG ulTileBytes = BG_TILE_SIZE * s_pTileset->BytesPerRow;
+
+	blitWait();
+	g_pCustom->bltcon0 = USEA | USED | MINTERM_A;
+	g_pCustom->bltcon1 = 0;
+	g_pCustom->bltafwm = 0xFFFF;
+	g_pCustom->bltalwm = 0xFFFF;
+	g_pCustom->bltamod = bitmapGetByteWidth(s_pTileset) - BG_TILE_SIZE / 8;
+	g_pCustom->bltdmod = bitmapGetByteWidth(pDst) - BG_TILE_SIZE / 8;
+
+	for(UBYTE ubY = 0; ubY < BG_TILES_Y; ++ubY) {
+		UBYTE *pRow = &pDst->Planes[0][ubY * BG_TILE_SIZE * pDst->BytesPerRow];
+		for(UBYTE ubX = 0; ubX < BG_TILES_X; ++ubX) {
+			blitWait();
+			g_pCustom->bltapt = &pTiles[s_pBgTileMap[ubX][ubY] * ulTileBytes];
+			g_pCustom->bltdpt = &pRow[ubX * (BG_TILE_SIZE / 8)];
+			g_pCustom->bltsize = uwBltSize;
+		}
+	}
+}
+
+// Composes tile row from tile indices using CPU. Tiles are single longword
+// wide on each plane, so each of their lines is one move. Used on 68020+,
+// which does it faster than the blitter, using 32-bit accesses.
+static void gameComposeTileRow(tBitMap *pDst, UBYTE ubY) {
+	UWORD uwSrcLongs = bitmapGetByteWidth(s_pTileset) / sizeof(ULONG);
+	UWORD uwDstLongs = bitmapGetByteWidth(pDst) / sizeof(ULONG);
+	ULONG ulTileBytes = BG_TILE_SIZE * s_pTileset->BytesPerRow;
+	ULONG *pRow = (ULONG*)&pDst->Planes[0][ubY * BG_TILE_SIZE * pDst->BytesPerRow];
+	for(UBYTE ubX = 0; ubX < BG_TILES_X; ++ubX) {
+		const ULONG *pSrc = (const ULONG*)&s_pTileset->Planes[0][
+			s_pBgTileMap[ubX][ubY] * ulTileBytes
+		];
+		ULONG *pDstTile = &pRow[ubX];
+		for(UWORD uwLine = 0; uwLine < BG_TILE_SIZE * GAME_BPP; ++uwLine) {
+			*pDstTile = *pSrc;
+			pSrc += uwSrcLongs;
+			pDstTile += uwDstLongs;
+		}
+	}
+}
+#endif
+
+// Copies whole rows of interleaved bitmap treating them as one tall plane,
+// so that only the blitter's height limit splits them into multiple blits.
+static void gameCopyRows(
+	const tBitMap *pSrc, UWORD uwSrcY, tBitMap *pDst, UWORD uwDstY, UWORD uwRows
+) {
+	UWORD uwByteWidth = bitmapGetByteWidth(pSrc);
+	ULONG ulLines = uwRows * pSrc->Depth;
+	UBYTE *pA = &pSrc->Planes[0][uwSrcY * pSrc->BytesPerRow];
+	UBYTE *pD = &pDst->Planes[0][uwDstY * pDst->BytesPerRow];
+
+	blitWait();
+	g_pCustom->bltcon0 = USEA | USED | MINTERM_A;
+	g_pCustom->bltcon1 = 0;
+	g_pCustom->bltafwm = 0xFFFF;
+	g_pCustom->bltalwm = 0xFFFF;
+	g_pCustom->bltamod = 0;
+	g_pCustom->bltdmod = 0;
+	while(ulLines) {
+		// Height of 1024 is encoded as 0
+		UWORD uwLines = MIN(ulLines, 1024);
+		blitWait();
+		g_pCustom->bltapt = pA;
+		g_pCustom->bltdpt = pD;
+		g_pCustom->bltsize = ((uwLines & 1023) << HSIZEBITS) | (uwByteWidth / 2);
+		pA += uwLines * uwByteWidth;
+		pD += uwLines * uwByteWidth;
+		ulLines -= uwLines;
+	}
+}
+#endif
+
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+// Redraws bg tile from its clean source into back buffer.
+static void stainRedrawBgTile(tUbCoordYX sTile) {
+	UWORD uwX = sTile.ubX << BG_TILE_SHIFT;
+	UWORD uwY = sTile.ubY << BG_TILE_SHIFT;
+#if defined(GAME_BG_RING_BUFFER)
+	if((UWORD)(uwY - s_uwBgRowsTop) >= s_uwBgRowsHeight) {
+		// Gets refilled from clean source once it's held again
+		return;
+	}
+#endif
+	gameRestoreBackground(
+		g_pGameBufferMain->pBack, uwX, uwY, uwX, uwY, BG_TILE_SIZE, BG_TILE_SIZE
+	);
+}
+
+// Takes oldest decal tile away from its bg tile, which goes back to plain
+// tileset & gets redrawn on both buffers, so that the oldest stain fades.
+// Decals of bg tiles in given range are skipped, since they're being reserved.
+static UBYTE stainDecalRecycle(
+	UBYTE ubFirstX, UBYTE ubFirstY, UBYTE ubLastX, UBYTE ubLastY
+) {
+	for(;;) {
+		UBYTE ubDecal = s_ubBgDecalNext;
+		if(++s_ubBgDecalNext == BG_DECAL_TILES_MAX) {
+			s_ubBgDecalNext = 0;
+		}
+		tUbCoordYX sTile = s_pBgDecalTiles[ubDecal];
+		if(
+			ubFirstX <= sTile.ubX && sTile.ubX <= ubLastX &&
+			ubFirstY <= sTile.ubY && sTile.ubY <= ubLastY
+		) {
+			continue;
+		}
+
+		gameSetTileIndex(s_pBgTileMap[sTile.ubX][sTile.ubY], sTile.ubX, sTile.ubY);
+		// Previous stains' blits may still be queued
+		blitQueueFence();
+		stainRedrawBgTile(sTile);
+		s_pBgTilesRecycled[s_ubBgTilesRecycledCount++] = sTile;
+#if defined(GAME_DEBUG)
+		++s_ulBgDecalsRecycled;
+#endif
+		return ubDecal;
+	}
 }
 
+// Reserves decal tiles for all bg tiles touched by stain at given position.
+// Either all of them get reserved or none, in which case stain is skipped.
+// Once all decal tiles are used, the oldest ones get recycled.
+static UBYTE stainDecalsReserve(UWORD uwX, UWORD uwY) {
+	UBYTE ubFirstX = uwX >> BG_TILE_SHIFT;
+	UBYTE ubFirstY = uwY >> BG_TILE_SHIFT;
+	UBYTE ubLastX = MIN((uwX + STAIN_SIZE_X - 1) >> BG_TILE_SHIFT, BG_TILES_X - 1);
+	UBYTE ubLastY = MIN((uwY + STAIN_SIZE_Y - 1) >> BG_TILE_SHIFT, BG_TILES_Y - 1);
+
+	UBYTE ubMissing = 0;
+	for(UBYTE ubX = ubFirstX; ubX <= ubLastX; ++ubX) {
+		for(UBYTE ubY = ubFirstY; ubY <= ubLastY; ++ubY) {
+			if(s_pBgDecalMap[ubX][ubY] == BG_DECAL_NONE) {
+				++ubMissing;
+			}
+		}
+	}
+	UBYTE ubFree = BG_DECAL_TILES_MAX - s_ubBgDecalCount;
+	if(
+		ubMissing > ubFree &&
+		s_ubBgTilesRecycledCount + ubMissing - ubFree > BG_DECAL_TILES_MAX
+	) {
+		// Too many recycled in this frame to track them for the other buffer
+		return 0;
+	}
+
+	for(UBYTE ubX = ubFirstX; ubX <= ubLastX; ++ubX) {
+		for(UBYTE ubY = ubFirstY; ubY <= ubLastY; ++ubY) {
+			if(s_pBgDecalMap[ubX][ubY] == BG_DECAL_NONE) {
+				UBYTE ubDecal = (
+					s_ubBgDecalCount < BG_DECAL_TILES_MAX ? s_ubBgDecalCount++ :
+					stainDecalRecycle(ubFirstX, ubFirstY, ubLastX, ubLastY)
+				);
+				s_pBgDecalMap[ubX][ubY] = ubDecal;
+				s_pBgDecalTiles[ubDecal] = (tUbCoordYX){.ubX = ubX, .ubY = ubY};
+			}
+		}
+	}
+	return 1;
+}
+
+// Copies bg tiles touched by stain from freshly undrawn back buffer into
+// their decal tiles & makes them the source of clean background.
+// Returns number of bytes copied.
+static UWORD stainDecalsCapture(UWORD uwX, UWORD uwY) {
+	UBYTE ubFirstX = uwX >> BG_TILE_SHIFT;
+	UBYTE ubFirstY = uwY >> BG_TILE_SHIFT;
+	UBYTE ubLastX = MIN((uwX + STAIN_SIZE_X - 1) >> BG_TILE_SHIFT, BG_TILES_X - 1);
+	UBYTE ubLastY = MIN((uwY + STAIN_SIZE_Y - 1) >> BG_TILE_SHIFT, BG_TILES_Y - 1);
+	UWORD uwBytes = 0;
+
+	for(UBYTE ubX = ubFirstX; ubX <= ubLastX; ++ubX) {
+		for(UBYTE ubY = ubFirstY; ubY <= ubLastY; ++ubY) {
+			UBYTE ubDecal = s_pBgDecalMap[ubX][ubY];
+			blitCopyAligned(
+				g_pGameBufferMain->pBack,
+				ubX * BG_TILE_SIZE, BG_BUFFER_Y(ubY * BG_TILE_SIZE),
+				s_pBgDecals, 0, ubDecal * BG_TILE_SIZE, BG_TILE_SIZE, BG_TILE_SIZE
+			);
+			s_pBgTilePlanes[ubX][ubY] = &s_pBgDecals->Planes[0][
+				ubDecal * BG_TILE_SIZE * s_pBgDecals->BytesPerRow
+			];
+			uwBytes += BG_TILE_SIZE * s_pBgDecals->BytesPerRow;
+		}
+	}
+	return uwBytes;
+}
+#endif
+
+#if defined(GAME_BG_RING_BUFFER)
+// Composes given rows of bg tiles from their clean data into ring buffer.
+// Both tileset & decals are one tile wide, so source has no modulo.
+static void gameDrawTileRows(tBitMap *pDst, UBYTE ubFirstY, UBYTE ubLastY) {
+	UWORD uwBltSize = ((BG_TILE_SIZE * GAME_BPP) << HSIZEBITS) | (BG_TILE_SIZE / 16);
+
+	blitWait();
+	g_pCustom->bltcon0 = USEA | USED | MINTERM_A;
+	g_pCustom->bltcon1 = 0;
+	g_pCustom->bltafwm = 0xFFFF;
+	g_pCustom->bltalwm = 0xFFFF;
+	g_pCustom->bltamod = 0;
+	g_pCustom->bltdmod = bitmapGetByteWidth(pDst) - BG_TILE_SIZE / 8;
+
+	for(UBYTE ubY = ubFirstY; ubY <= ubLastY; ++ubY) {
+		UBYTE *pRow = &pDst->Planes[0][g_pRowOffsetFromY[ubY << BG_TILE_SHIFT]];
+		for(UBYTE ubX = 0; ubX < BG_TILES_X; ++ubX) {
+			blitWait();
+			g_pCustom->bltapt = s_pBgTilePlanes[ubX][ubY];
+			g_pCustom->bltdpt = &pRow[ubX * (BG_TILE_SIZE / 8)];
+			g_pCustom->bltsize = uwBltSize;
+		}
+	}
+}
+
+// Draws bg tile rows which got into area around camera since buffer was last
+// refilled. Rows which left it are dropped, since bobs drawn beyond it may
+// wrap onto them.
+static void gameBufferRefill(tBitMap *pBuffer, UBYTE *pTop, UBYTE *pBottom) {
+	UWORD uwCameraY = g_pGameBufferMain->pCamera->uPos.uwY;
+	UBYTE ubFirst = (MAX(uwCameraY, BG_RING_MARGIN_Y) - BG_RING_MARGIN_Y) >> BG_TILE_SHIFT;
+	UBYTE ubLast = MIN(
+		(uwCameraY + GAME_MAIN_VPORT_SIZE_Y + BG_RING_MARGIN_Y - 1) >> BG_TILE_SHIFT,
+		BG_TILES_Y - 1
+	);
+
+	if(*pTop == BG_RING_TILE_NONE || ubLast < *pTop || *pBottom < ubFirst) {
+		gameDrawTileRows(pBuffer, ubFirst, ubLast);
+	}
+	else {
+		if(ubFirst < *pTop) {
+			gameDrawTileRows(pBuffer, ubFirst, *pTop - 1);
+		}
+		if(ubLast > *pBottom) {
+			gameDrawTileRows(pBuffer, *pBottom + 1, ubLast);
+		}
+	}
+	*pTop = ubFirst;
+	*pBottom = ubLast;
+}
+
+static void gameBufferInitCopper(tCopBfr *pCopBfr, UWORD uwCopperOffset) {
+	tCopCmd *pCmdList = &pCopBfr->pList[uwCopperOffset];
+	UWORD uwModulo = BG_BYTES_PER_PIXEL_ROW - (GAME_MAIN_VPORT_SIZE_X / 8 + 2);
+
+	// First one is game's bplcon0 move
+	copSetMove(&pCmdList[1].sMove, &g_pCustom->bplcon1, 0);
+	copSetMove(&pCmdList[2].sMove, &g_pCustom->ddfstrt, 0x0030);
+	copSetMove(&pCmdList[3].sMove, &g_pCustom->ddfstop, 0x00D0);
+	copSetMove(&pCmdList[4].sMove, &g_pCustom->bpl1mod, uwModulo);
+	copSetMove(&pCmdList[5].sMove, &g_pCustom->bpl2mod, uwModulo);
+	copSetWait(&pCmdList[BG_RING_COP_BREAK_POS].sWait, 0, 0);
+	copSetWait(&pCmdList[BG_RING_COP_BREAK_POS + 1].sWait, 0, 0);
+	for(UBYTE i = 0; i < GAME_BPP; ++i) {
+		copSetMove(&pCmdList[6 + 2 * i].sMove, &g_pBplFetch[i].uwHi, 0);
+		copSetMove(&pCmdList[6 + 2 * i + 1].sMove, &g_pBplFetch[i].uwLo, 0);
+		copSetMove(&pCmdList[BG_RING_COP_BREAK_POS + 2 + 2 * i].sMove, &g_pBplFetch[i].uwHi, 0);
+		copSetMove(&pCmdList[BG_RING_COP_BREAK_POS + 2 + 2 * i + 1].sMove, &g_pBplFetch[i].uwLo, 0);
+	}
+}
+
+// Same scroll setup as simple buffer's, but bitplane pointers are moved back
+// to buffer's top after last line before wrap gets fetched.
+static void gameBufferSetCopper(
+	const tGameRingBuffer *pManager, tCopBfr *pCopBfr, const tBitMap *pBuffer,
+	UWORD uwX, UWORD uwY
+) {
+	tCopCmd *pCmdList = &pCopBfr->pList[pManager->uwCopperOffset];
+	UWORD uwShift = (16 - (uwX & 0xF)) & 0xF;
+	ULONG ulColOffs = ((uwX - 1) >> 4) << 1;
+	UWORD uwBufferY = BG_BUFFER_Y(uwY);
+	UWORD uwRowsToWrap = MIN(BG_RING_SIZE_Y - uwBufferY, GAME_MAIN_VPORT_SIZE_Y);
+	ULONG ulTopOffs = uwBufferY * pBuffer->BytesPerRow + ulColOffs;
+
+	copSetMoveVal(&pCmdList[1].sMove, (uwShift << 4) | uwShift);
+	for(UBYTE i = 0; i < GAME_BPP; ++i) {
+		ULONG ulTop = (ULONG)&pBuffer->Planes[i][ulTopOffs];
+		ULONG ulWrap = (ULONG)&pBuffer->Planes[i][ulColOffs];
+		copSetMoveVal(&pCmdList[6 + 2 * i].sMove, ulTop >> 16);
+		copSetMoveVal(&pCmdList[6 + 2 * i + 1].sMove, ulTop & 0xFFFF);
+		copSetMoveVal(&pCmdList[BG_RING_COP_BREAK_POS + 2 + 2 * i].sMove, ulWrap >> 16);
+		copSetMoveVal(&pCmdList[BG_RING_COP_BREAK_POS + 2 + 2 * i + 1].sMove, ulWrap & 0xFFFF);
+	}
+
+	// Without wrap in view, pointers are reset past its last line. Copper
+	// compares only 8 bits of line, so past 255 it must wait for its end first.
+	UWORD uwWaitY = (
+		pManager->sCommon.pVPort->pView->ubPosY + GAME_HUD_VPORT_SIZE_Y +
+		uwRowsToWrap - 1
+	);
+	if(uwWaitY <= 0xFF) {
+		copSetWait(&pCmdList[BG_RING_COP_BREAK_POS].sWait, 0xDF, uwWaitY);
+		copSetWait(&pCmdList[BG_RING_COP_BREAK_POS + 1].sWait, 0, 0);
+	}
+	else {
+		copSetWait(&pCmdList[BG_RING_COP_BREAK_POS].sWait, 0xDF, 0xFF);
+		copSetWait(&pCmdList[BG_RING_COP_BREAK_POS + 1].sWait, 0xDF, uwWaitY & 0xFF);
+	}
+}
+
+// Points both copper lists at given buffer once current frame's display is
+// done, so that it gets shown regardless of which list is active.
+static void gameBufferShow(const tBitMap *pBuffer, UWORD uwY) {
+	tGameRingBuffer *pManager = g_pGameBufferMain;
+	tCopList *pCopList = pManager->sCommon.pVPort->pView->pCopList;
+	UWORD uwX = pManager->pCamera->uPos.uwX;
+
+	vPortWaitForEnd(pManager->sCommon.pVPort);
+	gameBufferSetCopper(pManager, pCopList->pFrontBfr, pBuffer, uwX, uwY);
+	gameBufferSetCopper(pManager, pCopList->pBackBfr, pBuffer, uwX, uwY);
+}
+
+// Brings back map camera position after gameBufferUnwrap(). Buffers are
+// refilled one at a time, so that the shown one is never drawn on.
+static void gameBufferRewrap(void) {
+	tGameRingBuffer *pManager = g_pGameBufferMain;
+	pManager->pCamera->uPos.uwY = s_uwBufferUnwrapY;
+	s_uwBufferUnwrapY = 0;
+	s_isBufferUnwrapped = 0;
+
+	pManager->ubBackTileTop = BG_RING_TILE_NONE;
+	gameBufferRefill(
+		pManager->pBack, &pManager->ubBackTileTop, &pManager->ubBackTileBottom
+	);
+	blitWait();
+	gameBufferShow(pManager->pBack, pManager->pCamera->uPos.uwY);
+
+	pManager->ubFrontTileTop = BG_RING_TILE_NONE;
+	gameBufferRefill(
+		pManager->pFront, &pManager->ubFrontTileTop, &pManager->ubFrontTileBottom
+	);
+	blitWait();
+	gameBufferShow(pManager->pFront, pManager->pCamera->uPos.uwY);
+}
+
+static void gameBufferProcess(tGameRingBuffer *pManager) {
+	const tUwCoordYX *pPos = &pManager->pCamera->uPos;
+	gameBufferSetCopper(
+		pManager, pManager->sCommon.pVPort->pView->pCopList->pBackBfr,
+		pManager->pBack, pPos->uwX, pPos->uwY
+	);
+
+	tBitMap *pTmp = pManager->pBack;
+	pManager->pBack = pManager->pFront;
+	pManager->pFront = pTmp;
+	UBYTE ubTmp = pManager->ubBackTileTop;
+	pManager->ubBackTileTop = pManager->ubFrontTileTop;
+	pManager->ubFrontTileTop = ubTmp;
+	ubTmp = pManager->ubBackTileBottom;
+	pManager->ubBackTileBottom = pManager->ubFrontTileBottom;
+	pManager->ubFrontTileBottom = ubTmp;
+}
+
+static void gameBufferDestroy(tGameRingBuffer *pManager) {
+	logBlockBegin("gameBufferDestroy(pManager: %p)", pManager);
+	bitmapDestroy(pManager->pFront);
+	bitmapDestroy(pManager->pBack);
+	memFree(pManager, sizeof(*pManager));
+	logBlockEnd("gameBufferDestroy()");
+}
+
+// Double buffer holding only BG_RING_SIZE_Y rows of whole map width. Its
+// camera still works in map coords, rows are wrapped by copper & blits.
+static tGameRingBuffer *gameBufferCreate(tVPort *pVPort, UWORD uwCopperOffset) {
+	logBlockBegin(
+		"gameBufferCreate(pVPort: %p, uwCopperOffset: %hu)",
+		pVPort, uwCopperOffset
+	);
+	tGameRingBuffer *pManager = memAllocFastClear(sizeof(*pManager));
+	pManager->sCommon.process = (tVpManagerFn)gameBufferProcess;
+	pManager->sCommon.destroy = (tVpManagerFn)gameBufferDestroy;
+	pManager->sCommon.ubId = VPM_SCROLL;
+	pManager->sCommon.pVPort = pVPort;
+	pManager->uwCopperOffset = uwCopperOffset;
+
+	pManager->pFront = bitmapCreate(
+		MAP_TILES_X * MAP_TILE_SIZE, BG_RING_SIZE_Y, GAME_BPP,
+		BMF_INTERLEAVED | BMF_CLEAR
+	);
+	pManager->pBack = bitmapCreate(
+		MAP_TILES_X * MAP_TILE_SIZE, BG_RING_SIZE_Y, GAME_BPP,
+		BMF_INTERLEAVED | BMF_CLEAR
+	);
+	pManager->ubFrontTileTop = BG_RING_TILE_NONE;
+	pManager->ubBackTileTop = BG_RING_TILE_NONE;
+
+	pManager->pCamera = cameraCreate(
+		pVPort, 0, 0,
+		MAP_TILES_X * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_X,
+		MAP_TILES_Y * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_Y, 1
+	);
+
+	gameBufferInitCopper(pVPort->pView->pCopList->pFrontBfr, uwCopperOffset);
+	gameBufferInitCopper(pVPort->pView->pCopList->pBackBfr, uwCopperOffset);
+	vPortAddManager(pVPort, (tVpManager*)pManager);
+	logBlockEnd("gameBufferCreate()");
+	return pManager;
+}
+#endif
+
 __attribute__((always_inline))
 static inline UBYTE isPositionCollidingWithEntity(
 	tUwCoordYX sPos, const tEntity *pEntity
@@ -643,6 +1421,15 @@ static inline tEntity *entityGetNearPos(
 	return s_pCollisionTiles[uwLookupX][uwLookupY];
 }
 
+__attribute__((always_inline))
+static inline tUwCoordYX respawnSlotGet(tUwCoordYX sPos, UBYTE ubSlot) {
+	tUwCoordYX sSlot = {
+		.uwX = g_pRespawnSlotX[sPos.uwX / COLLISION_SIZE_X][ubSlot],
+		.uwY = g_pRespawnSlotY[sPos.uwY / COLLISION_SIZE_Y][ubSlot]
+	};
+	return sSlot;
+}
+
 __attribute__((always_inline))
 static inline UBYTE enemyTryMoveBy(tEntity *pEnemy, LONG lDeltaX, LONG lDeltaY) {
 	tUwCoordYX sGoodPos = pEnemy->sPos;
@@ -846,13 +1633,14 @@ static inline UBYTE playerTryMoveBy(tEntity *pPlayer, LONG lDeltaX, LONG lDeltaY
 __attribute__((always_inline))
 static inline void projectileUndrawNext(void) {
 	if(s_pCurrentProjectile == &s_pProjectiles[PROJECTILE_COUNT]) {
-		g_pCustom->dmacon = DMAF_SETCLR | DMAF_BLITHOG;
+		blitHogPhaseBegin(BLIT_HOG_PHASE_DRAW);
 		return;
 	}
 
 	if(s_pCurrentProjectile->ubLife) {
 		ULONG ulOffset = s_pCurrentProjectile->pPrevOffsets[s_ubBufferCurr];
 		UBYTE *pTargetPlanes = &s_pBackPlanes[ulOffset];
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 		UBYTE *pBgPlanes = &s_pPristinePlanes[ulOffset];
 
 		for(UBYTE ubPlane = GAME_BPP; ubPlane--;) {
@@ -860,11 +1648,25 @@ static inline void projectileUndrawNext(void) {
 			pTargetPlanes += BG_BYTES_PER_BITPLANE_ROW;
 			pBgPlanes += BG_BYTES_PER_BITPLANE_ROW;
 		}
+#else
+		// Tile entry is read now rather than on draw so that stain decal
+		// captured in between is respected.
+		UBYTE *pBgPlanes = (
+			*s_pCurrentProjectile->pPrevBgTiles[s_ubBufferCurr] +
+			s_pCurrentProjectile->pPrevBgTileOffsets[s_ubBufferCurr]
+		);
+
+		for(UBYTE ubPlane = GAME_BPP; ubPlane--;) {
+			*pTargetPlanes = *pBgPlanes;
+			pTargetPlanes += BG_BYTES_PER_BITPLANE_ROW;
+			pBgPlanes += BG_TILE_BYTES_PER_BITPLANE_ROW;
+		}
+#endif
 
 		--s_pCurrentProjectile->ubLife;
 		if(s_pCurrentProjectile->ubLife) {
-			s_pCurrentProjectile->fX = fix10p6Add(s_pCurrentProjectile->fX, s_pCurrentProjectile->fDx);
-			s_pCurrentProjectile->fY = fix10p6Add(s_pCurrentProjectile->fY, s_pCurrentProjectile->fDy);
+			s_pCurrentProjectile->fX = fix26p6Add(s_pCurrentProjectile->fX, s_pCurrentProjectile->fDx);
+			s_pCurrentProjectile->fY = fix26p6Add(s_pCurrentProjectile->fY, s_pCurrentProjectile->fDy);
 		}
 		else {
 			s_pFreeProjectiles[s_ubFreeProjectileCount++] = s_pCurrentProjectile;
@@ -882,34 +1684,56 @@ static inline void projectileDrawNext(void) {
 
 	UBYTE *pTargetPlanes = s_pBackPlanes;
 	if(s_pCurrentProjectile->ubLife > 1) {
-		UWORD uwProjectileX = fix10p6ToUword(s_pCurrentProjectile->fX);
-		UWORD uwProjectileY = fix10p6ToUword(s_pCurrentProjectile->fY);
+		// Going past left or top edge wraps position to huge value
+		ULONG ulProjectileX = fix26p6ToUlong(s_pCurrentProjectile->fX);
+		ULONG ulProjectileY = fix26p6ToUlong(s_pCurrentProjectile->fY);
+		UWORD uwProjectileX = ulProjectileX;
+		UWORD uwProjectileY = ulProjectileY;
 		tEntity *pEnemy;
-		if(uwProjectileX >= MAP_TILES_X * MAP_TILE_SIZE || uwProjectileY >= MAP_TILES_Y * MAP_TILE_SIZE) {
+		if(ulProjectileX >= MAP_TILES_X * MAP_TILE_SIZE || ulProjectileY >= MAP_TILES_Y * MAP_TILE_SIZE) {
 			// TODO: Remove in favor of dummy entries in collision tiles at the edges
 			s_pCurrentProjectile->ubLife = 1; // so that it will be undrawn on both buffers
 		}
+#if defined(GAME_BG_RING_BUFFER)
+		else if((UWORD)(uwProjectileY - s_uwBgRowsTop) >= s_uwBgRowsHeight) {
+			// Off-screen & its row would wrap onto other one held by buffer
+			s_pCurrentProjectile->ubLife = 1;
+		}
+#endif
 		else if(
 			((pEnemy = entityGetNearPos(uwProjectileX, 0, uwProjectileY, 0)) && pEnemy->eKind == ENTITY_KIND_ENEMY) ||
 			((pEnemy = entityGetNearPos(uwProjectileX, -1, uwProjectileY, 0)) && pEnemy->eKind == ENTITY_KIND_ENEMY) ||
 			((pEnemy = entityGetNearPos(uwProjectileX, 0, uwProjectileY, -1)) && pEnemy->eKind == ENTITY_KIND_ENEMY) ||
 			((pEnemy = entityGetNearPos(uwProjectileX, -1, uwProjectileY, -1)) && pEnemy->eKind == ENTITY_KIND_ENEMY)
 		) {
-			if(s_pNextFreeStain != &s_pFreeStains[0]) {
-				tBob *pStain = *(--s_pNextFreeStain);
-				pStain->sPos.uwX = uwProjectileX;
-				pStain->sPos.uwY = uwProjectileY;
-				*(s_pNextPushStain++) = pStain;
+			// Queue is drained down to STAIN_QUEUE_FORCE_THRESHOLD each frame,
+			// leaving room for hits of all projectiles from 2 frames.
+			tStain *pStain = &s_pStains[s_ubStainFree];
+			s_ubStainFree = (s_ubStainFree + 1) & STAIN_QUEUE_MASK;
+			pStain->uwX = uwProjectileX;
+			pStain->uwY = uwProjectileY;
+			pStain->pFrame = s_pNextStainOffset;
+			if(++s_pNextStainOffset == &s_pStainFrameOffsets[STAIN_FRAME_PRESET_COUNT]) {
+				s_pNextStainOffset = &s_pStainFrameOffsets[0];
 			}
 
 			s_pCurrentProjectile->ubLife = 1; // so that it will be undrawn on both buffers
 			pEnemy->wHealth -= s_pCurrentProjectile->ubDamage;
-			audioMixerPlaySfx(g_pSfxImpact, SFX_CHANNEL_IMPACT, SFX_PRIORITY_IMPACT, 0);
+			sfxQueueAdd(g_pSfxImpact, SFX_CHANNEL_IMPACT, SFX_PRIORITY_IMPACT, uwProjectileX, uwProjectileY);
 		}
 		else {
 			UBYTE ubMask = s_pBulletMaskFromX[uwProjectileX & 0x7];
-			ULONG ulOffset = s_pRowOffsetFromY[uwProjectileY] + (uwProjectileX / 8);
+			ULONG ulOffset = g_pRowOffsetFromY[uwProjectileY] + (uwProjectileX / 8);
 			s_pCurrentProjectile->pPrevOffsets[s_ubBufferCurr] = ulOffset;
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+			s_pCurrentProjectile->pPrevBgTiles[s_ubBufferCurr] = &s_pBgTilePlanes[
+				uwProjectileX >> BG_TILE_SHIFT
+			][uwProjectileY >> BG_TILE_SHIFT];
+			s_pCurrentProjectile->pPrevBgTileOffsets[s_ubBufferCurr] = (
+				(uwProjectileY & (BG_TILE_SIZE - 1)) * BG_TILE_BYTES_PER_PIXEL_ROW +
+				((uwProjectileX & (BG_TILE_SIZE - 1)) / 8)
+			);
+#endif
 			for(UBYTE ubPlane = GAME_BPP; ubPlane--;) {
 				pTargetPlanes[ulOffset] |= ubMask;
 				ulOffset += BG_BYTES_PER_BITPLANE_ROW;
@@ -970,6 +1794,34 @@ static void hudUpdateBulletColors(void) {
 	}
 }
 
+// Draws only digit cells which differ from already displayed ones.
+// Returns 1 if anything got drawn.
+static UBYTE hudDrawScoreDigits(void) {
+	UBYTE isDrawn = 0;
+	for(UBYTE ubPos = 0; ubPos < HUD_SCORE_DIGITS; ++ubPos) {
+		UBYTE ubDigit = HUD_SCORE_DIGIT_BLANK;
+		if(ubPos < s_ubScoreBcdLength) {
+			ubDigit = s_pScoreBcd[s_ubScoreBcdLength - 1 - ubPos];
+		}
+		if(ubDigit == s_pHudScoreDigits[ubPos]) {
+			continue;
+		}
+
+		if(!isDrawn) {
+			blitQueueFence();
+			isDrawn = 1;
+		}
+		s_pHudScoreDigits[ubPos] = ubDigit;
+		blitCopy(
+			s_pBmHudDigits, 0, ubDigit * g_pFontSmall->uwHeight,
+			s_pBufferHud->pBack, HUD_SCORE_NUMBER_X + ubPos * HUD_SCORE_DIGIT_CELL_X,
+			HUD_SCORE_NUMBER_Y, HUD_SCORE_DIGIT_CELL_X, g_pFontSmall->uwHeight,
+			MINTERM_COPY
+		);
+	}
+	return isDrawn;
+}
+
 static void hudProcess(void) {
 	static char szScoreBuffer[sizeof("4294967295")];
 
@@ -979,7 +1831,7 @@ static void hudProcess(void) {
 			if(s_ubHudPendingPerksDrawn) {
 				if(!s_ubPendingPerks) {
 					s_ubHudPendingPerksDrawn = 0;
-					blitRect(
+					blitQueueRect(
 						s_pBufferHud->pBack, HUD_LEVEL_UP_OFFSET_X, HUD_LEVEL_UP_OFFSET_Y,
 						HUD_LEVEL_UP_SIZE_X, HUD_LEVEL_UP_SIZE_Y, COLOR_HUD_BG
 					);
@@ -989,7 +1841,7 @@ static void hudProcess(void) {
 			else {
 				if(s_ubPendingPerks) {
 					s_ubHudPendingPerksDrawn = 1;
-					blitCopyAligned(
+					blitQueueCopyAligned(
 						s_pHudLevelUp, 0, 0, s_pBufferHud->pBack,
 						HUD_LEVEL_UP_OFFSET_X, HUD_LEVEL_UP_OFFSET_Y,
 						HUD_LEVEL_UP_SIZE_X, HUD_LEVEL_UP_SIZE_Y
@@ -1003,10 +1855,10 @@ static void hudProcess(void) {
 			UWORD uwCurrentHealth = s_sPlayer.wHealth;
 			if(s_uwHudHealth != uwCurrentHealth) {
 				if(uwCurrentHealth > s_uwHudHealth) {
-					blitRect(s_pBufferHud->pBack, HUD_HEALTH_BAR_OFFSET_X + s_uwHudHealth, HUD_HEALTH_BAR_OFFSET_Y, uwCurrentHealth - s_uwHudHealth, HUD_HEALTH_BAR_SIZE_Y, COLOR_HUD_BAR_HP);
+					blitQueueRect(s_pBufferHud->pBack, HUD_HEALTH_BAR_OFFSET_X + s_uwHudHealth, HUD_HEALTH_BAR_OFFSET_Y, uwCurrentHealth - s_uwHudHealth, HUD_HEALTH_BAR_SIZE_Y, COLOR_HUD_BAR_HP);
 				}
 				else {
-					blitRect(s_pBufferHud->pBack, HUD_HEALTH_BAR_OFFSET_X + uwCurrentHealth, HUD_HEALTH_BAR_OFFSET_Y, s_uwHudHealth - uwCurrentHealth, HUD_HEALTH_BAR_SIZE_Y, COLOR_HUD_BAR_BG);
+					blitQueueRect(s_pBufferHud->pBack, HUD_HEALTH_BAR_OFFSET_X + uwCurrentHealth, HUD_HEALTH_BAR_OFFSET_Y, s_uwHudHealth - uwCurrentHealth, HUD_HEALTH_BAR_SIZE_Y, COLOR_HUD_BAR_BG);
 				}
 				s_uwHudHealth = uwCurrentHealth;
 				break;
@@ -1014,7 +1866,7 @@ static void hudProcess(void) {
 			// fallthrough
 		case HUD_STATE_DRAW_WEAPON:
 			++s_eHudState;
-			blitCopyAligned(
+			blitQueueCopyAligned(
 				s_pHudWeapons, 0, s_sPlayer.sPlayer.eWeaponKind * HUD_WEAPON_SIZE_Y,
 				s_pBufferHud->pBack, 0, 0, HUD_WEAPON_SIZE_X, HUD_WEAPON_SIZE_Y
 			);
@@ -1024,7 +1876,7 @@ static void hudProcess(void) {
 			if(s_ubHudAmmoCount != s_sPlayer.sPlayer.ubAmmo) {
 				if(s_ubHudAmmoCount == HUD_AMMO_COUNT_FORCE_REDRAW) {
 					s_ubHudAmmoCount = 0;
-					blitRect(
+					blitQueueRect(
 						s_pBufferHud->pBack, HUD_AMMO_FIELD_OFFSET_X, HUD_AMMO_FIELD_OFFSET_Y,
 						HUD_AMMO_FIELD_SIZE_X, HUD_AMMO_FIELD_SIZE_Y, COLOR_HUD_BG
 					);
@@ -1032,6 +1884,7 @@ static void hudProcess(void) {
 				else if(s_ubHudAmmoCount < s_sPlayer.sPlayer.ubAmmo) {
 					UBYTE ubDelta = s_sPlayer.sPlayer.ubAmmo - s_ubHudAmmoCount;
 					UBYTE ubDrawBulletCount = MIN(s_pHudBulletDefs[s_ubHudAmmoCount].ubMaxDrawDelta, ubDelta);
+					blitQueueFence();
 					blitCopyMask(
 						s_pBulletFrames, 0, 0, s_pBufferHud->pBack,
 						s_pHudBulletDefs[s_ubHudAmmoCount].sOffs.ubX,
@@ -1042,7 +1895,7 @@ static void hudProcess(void) {
 				}
 				else {
 					--s_ubHudAmmoCount;
-					blitRect(
+					blitQueueRect(
 						s_pBufferHud->pBack,
 						s_pHudBulletDefs[s_ubHudAmmoCount].sOffs.ubX,
 						s_pHudBulletDefs[s_ubHudAmmoCount].sOffs.ubY,
@@ -1052,44 +1905,26 @@ static void hudProcess(void) {
 				break;
 			}
 			// fallthrough
-		case HUD_STATE_PREPARE_EXP_POINTS:
-			if(s_ulHudScore != s_ulScore) {
-				s_ulHudScore = s_ulScore;
+		case HUD_STATE_DRAW_EXP_POINTS:
+			if(hudDrawScoreDigits()) {
 				++s_eHudState;
-				stringDecimalFromULong(s_ulScore, szScoreBuffer);
 			}
 			else {
 				s_eHudState = 0; // skip to beginning
 			}
 			break;
-		case HUD_STATE_PREPARE_EXP_POINTS_TBM:
-			++s_eHudState;
-			fontFillTextBitMap(g_pFontSmall, g_pLineBuffer, szScoreBuffer);
-			break;
-		case HUD_STATE_DRAW_EXP_POINTS:
-			++s_eHudState;
-			blitRect(
-				s_pBufferHud->pBack,
-				HUD_SCORE_NUMBER_X, HUD_SCORE_NUMBER_Y,
-				HUD_SCORE_NUMBER_SIZE_X, HUD_SCORE_NUMBER_SIZE_Y, COLOR_HUD_BG
-			);
-			fontDrawTextBitMap(
-				s_pBufferHud->pBack, g_pLineBuffer, HUD_SCORE_NUMBER_X, HUD_SCORE_NUMBER_Y,
-				COLOR_HUD_DIGITS & ~COLOR_HUD_BAR_BG, FONT_COOKIE | FONT_LAZY
-			);
-			break;
 		case HUD_STATE_DRAW_EXP_BAR:
 			++s_eHudState;
 			UBYTE ubNewHudBarPixel = (s_ulScore - s_ulPrevLevelScore) * HUD_SCORE_BAR_SIZE_X / (s_ulNextLevelScore - s_ulPrevLevelScore);
 			if(ubNewHudBarPixel > s_ubHudBarPixel) {
-				blitRect(
+				blitQueueRect(
 					s_pBufferHud->pBack,
 					HUD_SCORE_BAR_OFFSET_X + s_ubHudBarPixel, HUD_SCORE_BAR_OFFSET_Y,
 					ubNewHudBarPixel - s_ubHudBarPixel, HUD_SCORE_BAR_SIZE_Y, COLOR_HUD_BAR_SCORE
 				);
 			}
 			else if(ubNewHudBarPixel < s_ubHudBarPixel) {
-				blitRect(
+				blitQueueRect(
 					s_pBufferHud->pBack,
 					HUD_SCORE_BAR_OFFSET_X + ubNewHudBarPixel, HUD_SCORE_BAR_OFFSET_Y,
 					s_ubHudBarPixel - ubNewHudBarPixel, HUD_SCORE_BAR_SIZE_Y, COLOR_HUD_BAR_BG
@@ -1109,15 +1944,17 @@ static void hudProcess(void) {
 			break;
 		case HUD_STATE_PREPARE_LEVEL_NUM_TBM:
 			++s_eHudState;
+			blitQueueFence();
 			fontFillTextBitMap(g_pFontSmall, g_pLineBuffer, szScoreBuffer);
 			break;
 		case HUD_STATE_DRAW_LEVEL_NUM: {
 			s_eHudState = 0; // HUD_STATE_END
-			blitRect(
+			blitQueueRect(
 				s_pBufferHud->pBack,
 				HUD_LEVEL_NUMBER_X, HUD_LEVEL_NUMBER_Y,
 				HUD_LEVEL_NUMBER_SIZE_X, HUD_LEVEL_NUMBER_SIZE_Y, COLOR_HUD_BG
 			);
+			blitQueueFence();
 			fontDrawTextBitMap(
 				s_pBufferHud->pBack, g_pLineBuffer, HUD_LEVEL_NUMBER_X, HUD_LEVEL_NUMBER_Y,
 				COLOR_HUD_DIGITS & ~COLOR_HUD_BAR_BG, FONT_COOKIE | FONT_LAZY
@@ -1129,18 +1966,20 @@ static void hudProcess(void) {
 static void hudReset(void) {
 	s_uwHudHealth = 0;
 	s_ubHudAmmoCount = HUD_AMMO_COUNT_FORCE_REDRAW;
-	s_ulHudScore = 1;
+	for(UBYTE i = 0; i < HUD_SCORE_DIGITS; ++i) {
+		s_pHudScoreDigits[i] = HUD_SCORE_DIGIT_REDRAW;
+	}
 	s_ubHudLevel = 255;
 	s_ubHudBarPixel = 0;
 	s_eHudState = 0;
 	s_ubHudPendingPerksDrawn = !s_ubPendingPerks;
 
-	blitRect(
+	blitQueueRect(
 		s_pBufferHud->pBack,
 		HUD_SCORE_BAR_OFFSET_X, HUD_SCORE_BAR_OFFSET_Y,
 		HUD_SCORE_BAR_SIZE_X, HUD_SCORE_BAR_SIZE_Y, COLOR_HUD_BAR_BG
 	);
-	blitRect(
+	blitQueueRect(
 		s_pBufferHud->pBack,
 		HUD_HEALTH_BAR_OFFSET_X, HUD_HEALTH_BAR_OFFSET_Y,
 		HUD_HEALTH_BAR_SIZE_X, HUD_HEALTH_BAR_SIZE_Y, COLOR_HUD_BAR_BG
@@ -1175,7 +2014,8 @@ static void playerSetWeapon(tWeaponKind eWeaponKind) {
 	s_ubHudAmmoCount = HUD_AMMO_COUNT_FORCE_REDRAW;
 	gameSetCursor(CURSOR_KIND_FULL);
 	hudUpdateBulletColors();
-	audioMixerPlaySfx(g_pSfxReloadFinal, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, 0);
+	sfxSequenceStop(SFX_CHANNEL_RELOAD);
+	sfxQueueAdd(g_pSfxReloadFinal, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 }
 
 __attribute__((always_inline))
@@ -1185,13 +2025,11 @@ static inline void playerStartReloadWeapon(void) {
 	// s_sPlayer.sPlayer.bReloadCooldown = 1;
 	gameSetCursor(CURSOR_KIND_EMPTY);
 	s_isFinalReloadSfxPlayed = 0;
-	s_ubReloadClickCooldown = RELOAD_CLICK_COOLDOWN;
-	s_ubReloadClickIndex = 1;
-	audioMixerPlaySfx(g_pSfxReloadClicks[0], SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, 0);
+	sfxSequencePlay(&s_sReloadClickSequence, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD);
 }
 
 __attribute__((always_inline))
-static inline void playerShootProjectile(BYTE bAngle, BYTE pSpreadSide[static SPREAD_SIDE_COUNT], UBYTE ubDamage) {
+static inline void playerShootProjectile(BYTE bAngle, const BYTE pSpreadSide[static SPREAD_SIDE_COUNT], UBYTE ubDamage) {
 	static UBYTE s_ubSpread = 0;
 	static UBYTE s_ubSpreadSide = 0;
 
@@ -1209,8 +2047,8 @@ static inline void playerShootProjectile(BYTE bAngle, BYTE pSpreadSide[static SP
 		pProjectile->ubDamage = ubDamage;
 		pProjectile->fDx = fix10p6Cos(bAngle) * PROJECTILE_SPEED;
 		pProjectile->fDy = fix10p6Sin(bAngle) * PROJECTILE_SPEED;
-		pProjectile->fX = fix10p6FromUword(s_sPlayer.sPos.uwX);
-		pProjectile->fY = fix10p6FromUword(s_sPlayer.sPos.uwY);
+		pProjectile->fX = fix26p6FromUword(s_sPlayer.sPos.uwX);
+		pProjectile->fY = fix26p6FromUword(s_sPlayer.sPos.uwY);
 		if(s_ubSpread == 0) {
 			++s_ubSpread;
 		}
@@ -1235,28 +2073,28 @@ static void playerShootWeapon(UBYTE ubAimAngle) {
 	s_sPlayer.sPlayer.ubAttackCooldown = s_sPlayer.sPlayer.ubWeaponCooldown;
 	switch(eWeaponKind) {
 		case WEAPON_KIND_STOCK_RIFLE:
-			playerShootProjectile(ubAimAngle, s_pSpreadSide1, s_pWeaponDamages[WEAPON_KIND_STOCK_RIFLE]);
-			audioMixerPlaySfx(g_pSfxRifle, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, 0);
+			playerShootProjectile(ubAimAngle, g_pSpreadSide1, s_pWeaponDamages[WEAPON_KIND_STOCK_RIFLE]);
+			sfxQueueAdd(g_pSfxRifle, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 			break;
 		case WEAPON_KIND_SMG:
-			playerShootProjectile(ubAimAngle, s_pSpreadSide3, s_pWeaponDamages[WEAPON_KIND_SMG]);
-			audioMixerPlaySfx(g_pSfxSmg, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, 0);
+			playerShootProjectile(ubAimAngle, g_pSpreadSide3, s_pWeaponDamages[WEAPON_KIND_SMG]);
+			sfxQueueAdd(g_pSfxSmg, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 			break;
 		case WEAPON_KIND_ASSAULT_RIFLE:
-			playerShootProjectile(ubAimAngle, s_pSpreadSide2, s_pWeaponDamages[WEAPON_KIND_ASSAULT_RIFLE]);
-			audioMixerPlaySfx(g_pSfxAssault, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, 0);
+			playerShootProjectile(ubAimAngle, g_pSpreadSide2, s_pWeaponDamages[WEAPON_KIND_ASSAULT_RIFLE]);
+			sfxQueueAdd(g_pSfxAssault, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 			break;
 		case WEAPON_KIND_SHOTGUN:
 			for(UBYTE i = 0; i < 10; ++i) {
-				playerShootProjectile(ubAimAngle, s_pSpreadSide3, s_pWeaponDamages[WEAPON_KIND_SHOTGUN]);
+				playerShootProjectile(ubAimAngle, g_pSpreadSide3, s_pWeaponDamages[WEAPON_KIND_SHOTGUN]);
 			}
-			audioMixerPlaySfx(g_pSfxShotgun, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, 0);
+			sfxQueueAdd(g_pSfxShotgun, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 			break;
 		case WEAPON_KIND_SAWOFF:
 			for(UBYTE i = 0; i < 10; ++i) {
-				playerShootProjectile(ubAimAngle, s_pSpreadSide10, s_pWeaponDamages[WEAPON_KIND_SAWOFF]);
+				playerShootProjectile(ubAimAngle, g_pSpreadSide10, s_pWeaponDamages[WEAPON_KIND_SAWOFF]);
 			}
-			audioMixerPlaySfx(g_pSfxShotgun, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, 0);
+			sfxQueueAdd(g_pSfxShotgun, SFX_CHANNEL_SHOOT, SFX_PRIORITY_SHOOT, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 			break;
 	}
 }
@@ -1317,9 +2155,9 @@ static inline void enemyProcess(tEntity *pEnemy) {
 
 		if(pEnemy->sEnemy.ubAttackCooldown == 0) {
 			if((UWORD)wDistanceToPlayerX < 10 && (UWORD)wDistanceToPlayerY < 10) {
-				if(randUwMax(&g_sRand, 99) >= s_ubDodgeChance) {
+				if(gameRandUwMax(GAME_RAND_STREAM_ENEMIES, 99) >= s_ubDodgeChance) {
 					playerSetBlink(BLINK_KIND_HURT);
-					if(s_isDeathDance && randUwMax(&g_sRand, 99) < 5) {
+					if(s_isDeathDance && gameRandUwMax(GAME_RAND_STREAM_ENEMIES, 99) < 5) {
 						s_sPlayer.wHealth = 0;
 					}
 					if(!s_isImmortal) {
@@ -1333,7 +2171,7 @@ static inline void enemyProcess(tEntity *pEnemy) {
 						pEnemy->wHealth -= PLAYER_RETALIATION_DAMAGE;
 					}
 				}
-				audioMixerPlaySfx(g_pSfxBite, SFX_CHANNEL_BITE, SFX_PRIORITY_BITE, 0);
+				sfxQueueAdd(g_pSfxBite, SFX_CHANNEL_BITE, SFX_PRIORITY_BITE, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 				pEnemy->sEnemy.ubAttackCooldown = ENEMY_ATTACK_COOLDOWN;
 			}
 		}
@@ -1357,10 +2195,11 @@ static inline void enemyProcess(tEntity *pEnemy) {
 
 		tFrameOffset *pOffset = &s_pEnemyFrameOffsets[eDir][pEnemy->eFrame];
 		pEnemy->sEnemy.eDirection = eDir;
-		bobSetFrame(&pEnemy->sBob, pOffset->pPixels, pOffset->pMask);
-		pEnemy->sBob.sPos.uwX = pEnemy->sPos.uwX - ENEMY_BOB_OFFSET_X;
-		pEnemy->sBob.sPos.uwY = pEnemy->sPos.uwY - ENEMY_BOB_OFFSET_Y;
-		bobPush(&pEnemy->sBob);
+		bobSetFrameTrimmed(
+			&pEnemy->sBob, &pEnemy->ubBobTrimTop, pOffset,
+			pEnemy->sPos.uwX - ENEMY_BOB_OFFSET_X, pEnemy->sPos.uwY - ENEMY_BOB_OFFSET_Y
+		);
+		bobPushCulled(&pEnemy->sBob);
 	}
 	else {
 		if(pEnemy->wHealth == HEALTH_ENEMY_DEAD_AWAITING_RESPAWN) {
@@ -1369,7 +2208,7 @@ static inline void enemyProcess(tEntity *pEnemy) {
 				tUwCoordYX sClosest;
 				UWORD uwClosestDistance = 0xFFFF;
 				for(UBYTE i = 0; i < RESPAWN_SLOTS_PER_POSITION; ++i) {
-					tUwCoordYX sSpawn = s_pRespawnSlots[s_sPlayer.sPos.uwX / COLLISION_SIZE_X][s_sPlayer.sPos.uwY / COLLISION_SIZE_Y][i];
+					tUwCoordYX sSpawn = respawnSlotGet(s_sPlayer.sPos, i);
 					WORD wDx = sSpawn.uwX - s_sPlayer.sPos.uwX;
 					WORD wDy = sSpawn.uwY - s_sPlayer.sPos.uwY;
 
@@ -1383,30 +2222,34 @@ static inline void enemyProcess(tEntity *pEnemy) {
 					pEnemy->wHealth = s_uwEnemySpawnHealth;
 					s_pCollisionTiles[sClosest.uwX / COLLISION_SIZE_X][sClosest.uwY / COLLISION_SIZE_Y] = pEnemy;
 					pEnemy->sPos = sClosest;
-					if(randUwMax(&g_sRand, ENEMY_SPEEDY_CHANCE_MAX) <= s_ubHiSpeedChance) {
+					if(gameRandUwMax(GAME_RAND_STREAM_ENEMIES, ENEMY_SPEEDY_CHANCE_MAX) <= s_ubHiSpeedChance) {
 						pEnemy->sEnemy.ubSpeed = 2;
 						pEnemy->sEnemy.uwExp = ENEMY_EXP_HI_SPEED;
+						pEnemy->sEnemy.uwExpBcd = ENEMY_EXP_HI_SPEED_BCD;
 					}
 					else {
 						pEnemy->sEnemy.ubSpeed = 1;
 						pEnemy->sEnemy.uwExp = ENEMY_EXP;
+						pEnemy->sEnemy.uwExpBcd = ENEMY_EXP_BCD;
 					}
 					return;
 				}
 			}
 			else {
-				tUwCoordYX sSpawn = s_pRespawnSlots[s_sPlayer.sPos.uwX / COLLISION_SIZE_X][s_sPlayer.sPos.uwY / COLLISION_SIZE_Y][pEnemy->sEnemy.ubPreferredSpawn];
+				tUwCoordYX sSpawn = respawnSlotGet(s_sPlayer.sPos, pEnemy->sEnemy.ubPreferredSpawn);
 				if(!s_pCollisionTiles[sSpawn.uwX / COLLISION_SIZE_X][sSpawn.uwY / COLLISION_SIZE_Y]) {
 					pEnemy->wHealth = s_uwEnemySpawnHealth;
 					s_pCollisionTiles[sSpawn.uwX / COLLISION_SIZE_X][sSpawn.uwY / COLLISION_SIZE_Y] = pEnemy;
 					pEnemy->sPos = sSpawn;
-					if(randUwMax(&g_sRand, ENEMY_SPEEDY_CHANCE_MAX) <= s_ubHiSpeedChance) {
+					if(gameRandUwMax(GAME_RAND_STREAM_ENEMIES, ENEMY_SPEEDY_CHANCE_MAX) <= s_ubHiSpeedChance) {
 						pEnemy->sEnemy.ubSpeed = 2;
 						pEnemy->sEnemy.uwExp = ENEMY_EXP_HI_SPEED;
+						pEnemy->sEnemy.uwExpBcd = ENEMY_EXP_HI_SPEED_BCD;
 					}
 					else {
 						pEnemy->sEnemy.ubSpeed = 1;
 						pEnemy->sEnemy.uwExp = ENEMY_EXP;
+						pEnemy->sEnemy.uwExpBcd = ENEMY_EXP_BCD;
 					}
 					return;
 				}
@@ -1425,15 +2268,15 @@ static inline void enemyProcess(tEntity *pEnemy) {
 				}
 			}
 			tFrameOffset *pOffset = &s_pEnemyFrameOffsets[pEnemy->sEnemy.eDirection][pEnemy->eFrame];
-			bobSetFrame(&pEnemy->sBob, pOffset->pPixels, pOffset->pMask);
-			bobPush(&pEnemy->sBob);
+			bobChangeFrameTrimmed(&pEnemy->sBob, &pEnemy->ubBobTrimTop, pOffset);
+			bobPushCulled(&pEnemy->sBob);
 		}
 		else {
 			if(pEnemy->wHealth == HEALTH_ENEMY_OFFSCREENED) {
 				pEnemy->wHealth = HEALTH_ENEMY_DEAD_AWAITING_RESPAWN;
 			}
 			else {
-				scoreAddSmall(pEnemy->sEnemy.uwExp);
+				scoreAddSmall(pEnemy->sEnemy.uwExp, pEnemy->sEnemy.uwExpBcd);
 				++s_ulKills;
 				if(s_sPickup.wHealth == HEALTH_PICKUP_INACTIVE) {
 					s_sPickup.wHealth = HEALTH_PICKUP_READY_TO_SPAWN;
@@ -1448,13 +2291,14 @@ static inline void enemyProcess(tEntity *pEnemy) {
 			// Failsafe to prevent trashing collision map
 			pEnemy->sPos.ulYX = 0;
 			// Display as-is to prevent flicker between alive and dead anim
-			bobPush(&pEnemy->sBob);
+			bobPushCulled(&pEnemy->sBob);
 		}
 	}
 }
 
-static void blitUnsafeCopyStain(
-	UBYTE *pSrc, UBYTE *pMsk, WORD wDstX, WORD wDstY
+static void blitUnsafeCopyStainPart(
+	UBYTE *pSrc, UBYTE *pMsk, UBYTE *pDstPlanes, WORD wDstX, WORD wDstY,
+	UBYTE ubHeight
 ) {
 	// Blitter register values
 	UBYTE ubDstDelta = wDstX & 0xF;
@@ -1467,27 +2311,162 @@ static void blitUnsafeCopyStain(
 	UBYTE ubShift = ubDstDelta;
 	UWORD uwBltCon1 = ubShift << BSHIFTSHIFT;
 
-	ULONG ulDstOffs = s_pRowOffsetFromY[wDstY] + (wDstX >> 3);
-	UBYTE *pCD = &g_pGamePristineBuffer->Planes[0][ulDstOffs];
+	ULONG ulDstOffs = g_pRowOffsetFromY[wDstY] + (wDstX >> 3);
+	UBYTE *pCD = &pDstPlanes[ulDstOffs];
 
 	UWORD uwBltCon0 = uwBltCon1 |USEA|USEB|USEC|USED | MINTERM_COOKIE;
+#if defined(GAME_SINGLE_PLANE_STAIN_MASKS)
+	// Mask has only one plane, so it can't follow the interleaved source
+	// in a single blit - do one blit per plane, rewinding the mask each time.
+	WORD wMskModulo = STAIN_BYTES_PER_BITPLANE_ROW - uwBlitWords * 2;
+	WORD wSrcModulo = STAIN_BYTES_PER_PIXEL_ROW - uwBlitWords * 2;
+	WORD wDstModulo = BG_BYTES_PER_PIXEL_ROW - uwBlitWords * 2;
+
+	for(UBYTE ubPlane = 0; ubPlane < GAME_BPP; ++ubPlane) {
+		tBlitQueueCmd *pCmd = blitQueueAlloc();
+		pCmd->uwBltCon0 = uwBltCon0;
+		pCmd->uwBltCon1 = uwBltCon1;
+		pCmd->uwFirstMask = uwFirstMask;
+		pCmd->uwLastMask = uwLastMask;
+		pCmd->wModA = wMskModulo;
+		pCmd->wModB = wSrcModulo;
+		pCmd->wModC = wDstModulo;
+		pCmd->wModD = wDstModulo;
+		pCmd->uwDataA = 0;
+		pCmd->pA = pMsk;
+		pCmd->pB = pSrc;
+		pCmd->pC = pCD;
+		pCmd->pD = pCD;
+		pCmd->uwBltSize = (ubHeight << HSIZEBITS) | uwBlitWords;
+		blitQueueCommit();
+		pSrc += STAIN_BYTES_PER_BITPLANE_ROW;
+		pCD += BG_BYTES_PER_BITPLANE_ROW;
+	}
+#else
 	WORD wSrcModulo = STAIN_BYTES_PER_BITPLANE_ROW - uwBlitWords * 2;
 	WORD wDstModulo = BG_BYTES_PER_BITPLANE_ROW - uwBlitWords * 2;
 
-	blitWait(); // Don't modify registers when other blit is in progress
-	g_pCustom->bltcon0 = uwBltCon0;
-	g_pCustom->bltcon1 = uwBltCon1;
-	g_pCustom->bltafwm = uwFirstMask;
-	g_pCustom->bltalwm = uwLastMask;
-	g_pCustom->bltamod = wSrcModulo;
-	g_pCustom->bltbmod = wSrcModulo;
-	g_pCustom->bltcmod = wDstModulo;
-	g_pCustom->bltdmod = wDstModulo;
-	g_pCustom->bltapt = pMsk;
-	g_pCustom->bltbpt = pSrc;
-	g_pCustom->bltcpt = pCD;
-	g_pCustom->bltdpt = pCD;
-	g_pCustom->bltsize = ((STAIN_SIZE_Y * GAME_BPP) << HSIZEBITS) | uwBlitWords;
+	tBlitQueueCmd *pCmd = blitQueueAlloc();
+	pCmd->uwBltCon0 = uwBltCon0;
+	pCmd->uwBltCon1 = uwBltCon1;
+	pCmd->uwFirstMask = uwFirstMask;
+	pCmd->uwLastMask = uwLastMask;
+	pCmd->wModA = wSrcModulo;
+	pCmd->wModB = wSrcModulo;
+	pCmd->wModC = wDstModulo;
+	pCmd->wModD = wDstModulo;
+	pCmd->uwDataA = 0;
+	pCmd->pA = pMsk;
+	pCmd->pB = pSrc;
+	pCmd->pC = pCD;
+	pCmd->pD = pCD;
+	pCmd->uwBltSize = ((ubHeight * GAME_BPP) << HSIZEBITS) | uwBlitWords;
+	blitQueueCommit();
+#endif
+}
+
+static void blitUnsafeCopyStain(
+	UBYTE *pSrc, UBYTE *pMsk, UBYTE *pDstPlanes, WORD wDstX, WORD wDstY
+) {
+#if defined(GAME_BG_RING_BUFFER)
+	// Rows past ring buffer's end continue at its top
+	UBYTE ubHeight = MIN(BG_RING_SIZE_Y - BG_BUFFER_Y(wDstY), STAIN_SIZE_Y);
+	if(ubHeight < STAIN_SIZE_Y) {
+		blitUnsafeCopyStainPart(pSrc, pMsk, pDstPlanes, wDstX, wDstY, ubHeight);
+		pSrc += ubHeight * STAIN_BYTES_PER_PIXEL_ROW;
+#if defined(GAME_SINGLE_PLANE_STAIN_MASKS)
+		pMsk += ubHeight * STAIN_BYTES_PER_BITPLANE_ROW;
+#else
+		pMsk += ubHeight * STAIN_BYTES_PER_PIXEL_ROW;
+#endif
+		blitUnsafeCopyStainPart(
+			pSrc, pMsk, pDstPlanes, wDstX, wDstY + ubHeight,
+			STAIN_SIZE_Y - ubHeight
+		);
+		return;
+	}
+#endif
+	blitUnsafeCopyStainPart(pSrc, pMsk, pDstPlanes, wDstX, wDstY, STAIN_SIZE_Y);
+}
+
+// Stains may only be stamped & captured on rows held by back buffer.
+static inline UBYTE stainIsOnBackBuffer(UNUSED_ARG const tStain *pStain) {
+#if defined(GAME_BG_RING_BUFFER)
+	return (UWORD)(pStain->uwY - s_uwBgRowsTop) <= s_uwBgRowsHeight - STAIN_SIZE_Y;
+#else
+	return 1;
+#endif
+}
+
+// Back buffer has just been undrawn, so stains go straight into it - bobs
+// will save or restore the background beneath them with stains already there.
+static void stainsProcessUndrawn(void) {
+	// Stamped on the other buffer in previous frame
+	while(s_ubStainStamped != s_ubStainPending) {
+		const tStain *pStain = &s_pStains[s_ubStainStamped];
+		if(pStain->pFrame && stainIsOnBackBuffer(pStain)) {
+			blitUnsafeCopyStain(
+				pStain->pFrame->pPixels, pStain->pFrame->pMask, s_pBackPlanes,
+				pStain->uwX, pStain->uwY
+			);
+		}
+		s_ubStainStamped = (s_ubStainStamped + 1) & STAIN_QUEUE_MASK;
+	}
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	// Also after stamps above, since they may land on recycled tiles
+	if(s_ubBgTilesRecycledCount) {
+		blitQueueFence();
+		for(UBYTE i = 0; i < s_ubBgTilesRecycledCount; ++i) {
+			stainRedrawBgTile(s_pBgTilesRecycled[i]);
+		}
+		s_ubBgTilesRecycledCount = 0;
+	}
+#endif
+
+	UBYTE ubPendingCount = (s_ubStainFree - s_ubStainPending) & STAIN_QUEUE_MASK;
+#if defined(GAME_DEBUG)
+	s_ubStainsPendingMax = MAX(s_ubStainsPendingMax, ubPendingCount);
+#endif
+	WORD wBudget = STAIN_BYTES_PER_FRAME;
+	while(
+		ubPendingCount &&
+		(wBudget > 0 || ubPendingCount > STAIN_QUEUE_FORCE_THRESHOLD)
+	) {
+		tStain *pStain = &s_pStains[s_ubStainPending];
+#if defined(ACE_BOB_PRISTINE_BUFFER)
+		blitUnsafeCopyStain(
+			pStain->pFrame->pPixels, pStain->pFrame->pMask, s_pPristinePlanes,
+			pStain->uwX, pStain->uwY
+		);
+		blitUnsafeCopyStain(
+			pStain->pFrame->pPixels, pStain->pFrame->pMask, s_pBackPlanes,
+			pStain->uwX, pStain->uwY
+		);
+		// Includes the stamp on the other buffer in next frame
+		wBudget -= 3 * STAIN_BLIT_BYTES;
+#else
+		if(
+			stainIsOnBackBuffer(pStain) &&
+			stainDecalsReserve(pStain->uwX, pStain->uwY)
+		) {
+			blitUnsafeCopyStain(
+				pStain->pFrame->pPixels, pStain->pFrame->pMask, s_pBackPlanes,
+				pStain->uwX, pStain->uwY
+			);
+			blitQueueFence();
+			wBudget -= 2 * STAIN_BLIT_BYTES + stainDecalsCapture(pStain->uwX, pStain->uwY);
+		}
+		else {
+			// Out of rows or recycled too much - projectiles would erase it
+			pStain->pFrame = 0;
+		}
+#endif
+		s_ubStainPending = (s_ubStainPending + 1) & STAIN_QUEUE_MASK;
+		--ubPendingCount;
+	}
+
+	// Bob draws use blitter directly
+	blitQueueFence();
 }
 
 static void onVblank(
@@ -1518,13 +2497,118 @@ ULONG gameGetExp(void) {
 
 void gameResume(void) {
 	systemSetInt(INTB_VERTB, onVblank, (void*)&s_ulFrameCount);
+	blitHogDiscard();
+#if defined(MIXER_COUNTER)
+	// Don't count mixer load of other states
+	audioMixerProfileTake(0);
+#endif
 	hudReset();
+	// Callers & buffer rewrap below blit directly, so HUD blits queued by
+	// reset must not be running anymore.
+	blitQueueFence();
+	if(s_sPlayer.sPlayer.bReloadCooldown && !s_isFinalReloadSfxPlayed) {
+		sfxSequencePlay(&s_sReloadClickSequence, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD);
+	}
+#if defined(GAME_BG_RING_BUFFER)
+	if(s_isBufferUnwrapped) {
+		gameBufferRewrap();
+	}
+#endif
 }
 
 void gameDiscardUndraw(void) {
 	bobDiscardUndraw();
 }
 
+#if defined(GAME_BG_RING_BUFFER)
+void gameBufferUnwrap(void) {
+	if(s_isBufferUnwrapped) {
+		return;
+	}
+	tGameRingBuffer *pManager = g_pGameBufferMain;
+	UWORD uwCameraY = pManager->pCamera->uPos.uwY;
+	blitQueueFence();
+
+	// Copy shown rows to back buffer's top & show them from there, so that
+	// they can be copied to front buffer without tearing.
+	UWORD uwBufferY = BG_BUFFER_Y(uwCameraY);
+	UWORD uwRowsToWrap = MIN(BG_RING_SIZE_Y - uwBufferY, GAME_MAIN_VPORT_SIZE_Y);
+	gameCopyRows(pManager->pFront, uwBufferY, pManager->pBack, 0, uwRowsToWrap);
+	if(uwRowsToWrap < GAME_MAIN_VPORT_SIZE_Y) {
+		gameCopyRows(
+			pManager->pFront, 0, pManager->pBack, uwRowsToWrap,
+			GAME_MAIN_VPORT_SIZE_Y - uwRowsToWrap
+		);
+	}
+	blitWait();
+	gameBufferShow(pManager->pBack, 0);
+
+	gameCopyRows(pManager->pBack, 0, pManager->pFront, 0, GAME_MAIN_VPORT_SIZE_Y);
+	blitWait();
+	gameBufferShow(pManager->pFront, 0);
+
+	s_uwBufferUnwrapY = uwCameraY;
+	pManager->pCamera->uPos.uwY = 0;
+	s_isBufferUnwrapped = 1;
+	// Held rows got overwritten
+	pManager->ubFrontTileTop = BG_RING_TILE_NONE;
+	pManager->ubBackTileTop = BG_RING_TILE_NONE;
+}
+#endif
+
+void gameRestoreBackground(
+	tBitMap *pDst, UWORD uwDstX, UWORD uwDstY,
+	UWORD uwX, UWORD uwY, UWORD uwWidth, UWORD uwHeight
+) {
+	// Called by other states' overlays, which don't know about the queue
+	blitQueueFence();
+#if defined(ACE_BOB_PRISTINE_BUFFER)
+	blitCopy(
+		g_pGamePristineBuffer, uwX, uwY, pDst, uwDstX, uwDstY,
+		uwWidth, uwHeight, MINTERM_COPY
+	);
+#else
+#if defined(GAME_BG_RING_BUFFER)
+	// Overlays pass camera coords, which may be the unwrapped ones
+	uwY += s_uwBufferUnwrapY;
+	UBYTE isDstWrapped = (
+		pDst == g_pGameBufferMain->pFront || pDst == g_pGameBufferMain->pBack
+	);
+#endif
+	UWORD uwEndX = uwX + uwWidth;
+	UWORD uwEndY = uwY + uwHeight;
+	for(UWORD uwTileY = uwY >> BG_TILE_SHIFT; (uwTileY << BG_TILE_SHIFT) < uwEndY; ++uwTileY) {
+		UWORD uwPartY = MAX(uwY, uwTileY << BG_TILE_SHIFT);
+		UWORD uwPartEndY = MIN(uwEndY, (uwTileY + 1) << BG_TILE_SHIFT);
+		for(UWORD uwTileX = uwX >> BG_TILE_SHIFT; (uwTileX << BG_TILE_SHIFT) < uwEndX; ++uwTileX) {
+			UWORD uwPartX = MAX(uwX, uwTileX << BG_TILE_SHIFT);
+			UWORD uwPartEndX = MIN(uwEndX, (uwTileX + 1) << BG_TILE_SHIFT);
+
+			const tBitMap *pSrc = s_pTileset;
+			UBYTE ubSrcTile = s_pBgTileMap[uwTileX][uwTileY];
+			if(s_pBgDecalMap[uwTileX][uwTileY] != BG_DECAL_NONE) {
+				pSrc = s_pBgDecals;
+				ubSrcTile = s_pBgDecalMap[uwTileX][uwTileY];
+			}
+			UWORD uwPartDstY = uwDstY + uwPartY - uwY;
+#if defined(GAME_BG_RING_BUFFER)
+			// Parts don't cross the wrap - either they're in unwrapped top rows
+			// or at map coords, which are tile-aligned like the wrap.
+			if(isDstWrapped) {
+				uwPartDstY = BG_BUFFER_Y(uwPartDstY);
+			}
+#endif
+			blitCopy(
+				pSrc, uwPartX & (BG_TILE_SIZE - 1),
+				(ubSrcTile << BG_TILE_SHIFT) + (uwPartY & (BG_TILE_SIZE - 1)),
+				pDst, uwDstX + uwPartX - uwX, uwPartDstY,
+				uwPartEndX - uwPartX, uwPartEndY - uwPartY, MINTERM_COPY
+			);
+		}
+	}
+#endif
+}
+
 void gameProcessCursor(UWORD uwMouseX, UWORD uwMouseY) {
 	s_pSpriteCursor->wX = uwMouseX - GAME_CURSOR_OFFSET_X;
 	s_pSpriteCursor->wY = uwMouseY - GAME_CURSOR_OFFSET_Y;
@@ -1535,21 +2619,23 @@ void gameApplyPerk(tPerk ePerk) {
 	--s_ubPendingPerks;
 	perksLock(ePerk);
 	switch(ePerk) {
-		case PERK_GRIM_DEAL:
-			scoreAddLarge((s_ulScore * 2) / 10);
+		case PERK_GRIM_DEAL: {
+			ULONG ulGrimScore = (s_ulScore * 2) / 10;
+			scoreAddLarge(ulGrimScore, scoreBcdFromULong(ulGrimScore));
 			s_sPlayer.wHealth = 0;
 			break;
+		}
 		case PERK_FATAL_LOTTERY:
-			if(randUwMax(&g_sRand, 99) < 50) {
+			if(gameRandUwMax(GAME_RAND_STREAM_PERKS, 99) < 50) {
 				s_sPlayer.wHealth = 0;
 			}
 			else {
-				scoreAddLarge(20000);
+				scoreAddLarge(20000, 0x20000);
 			}
 			break;
 		case PERK_INSTANT_WINNER:
 			perksUnlock(ePerk); // multi-use
-			scoreAddLarge(2000);
+			scoreAddLarge(2000, 0x2000);
 			break;
 		case PERK_THICK_SKINNED:
 			s_sPlayer.wHealth = MAX(1, s_sPlayer.wHealth - 25);
@@ -1629,24 +2715,93 @@ void gameApplyPerk(tPerk ePerk) {
 
 void gameStart(void) {
 	UBYTE wasDweller = 0;
+	// Before anything else gets to queue sounds of the new game
+	sfxQueueReset(&g_pGameBufferMain->pCamera->uPos);
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	s_ubBgDecalCount = 0;
+	s_ubBgDecalNext = 0;
+	s_ubBgTilesRecycledCount = 0;
+#endif
+	// Stains of previous game must not land on the new map
+	s_ubStainStamped = 0;
+	s_ubStainPending = 0;
+	s_ubStainFree = 0;
+#if defined(GAME_DEBUG)
+	ULONG ulMapStart = timerGetPrec();
+#endif
+	blitQueueFence();
 	for(UBYTE ubX = 0; ubX < BG_TILES_X; ++ubX) {
 		for(UBYTE ubY = 0; ubY < BG_TILES_Y; ++ubY) {
-			UWORD uwRand = randUwMinMax(&g_sRand, 0, 99);
+			UWORD uwRand = gameRandUwMinMax(GAME_RAND_STREAM_MAP, 0, 99);
+			UBYTE ubTileIndex;
 			if(uwRand == 0 && !wasDweller) {
 				wasDweller = 1;
-				gameSetTile(15, ubX, ubY);
+				ubTileIndex = 15;
 			}
 			else if(uwRand < 5) {
-				gameSetTile(randUwMinMax(&g_sRand, 4, 10), ubX, ubY);
+				ubTileIndex = gameRandUwMinMax(GAME_RAND_STREAM_MAP, 4, 10);
 			}
 			else if(uwRand < 15) {
-				gameSetTile(randUwMinMax(&g_sRand, 11, 14), ubX, ubY);
+				ubTileIndex = gameRandUwMinMax(GAME_RAND_STREAM_MAP, 11, 14);
 			}
 			else {
-				gameSetTile(randUwMinMax(&g_sRand, 0, 3), ubX, ubY);
+				ubTileIndex = gameRandUwMinMax(GAME_RAND_STREAM_MAP, 0, 3);
 			}
+#if defined(GAME_MAP_GENERATE_PER_TILE)
+			gameSetTile(ubTileIndex, ubX, ubY);
+#else
+			gameSetTileIndex(ubTileIndex, ubX, ubY);
+#endif
+		}
+	}
+#if defined(GAME_BG_RING_BUFFER)
+	// Buffers get refilled around player's position by gameResume()
+#elif !defined(GAME_MAP_GENERATE_PER_TILE)
+	if(s_isMapComposedByCpu) {
+		// CPU composes next tile row while blitter copies previous one to
+		// other buffers, so there's a single blit per tile row & buffer.
+		for(UBYTE ubY = 0; ubY < BG_TILES_Y; ++ubY) {
+			gameComposeTileRow(g_pGameBufferMain->pBack, ubY);
+			UWORD uwY = ubY * BG_TILE_SIZE;
+			gameCopyRows(
+				g_pGameBufferMain->pBack, uwY, g_pGameBufferMain->pFront, uwY,
+				BG_TILE_SIZE
+			);
+#if defined(ACE_BOB_PRISTINE_BUFFER)
+			gameCopyRows(
+				g_pGameBufferMain->pBack, uwY, g_pGamePristineBuffer, uwY,
+				BG_TILE_SIZE
+			);
+#endif
 		}
 	}
+	else {
+		gameDrawMap(g_pGameBufferMain->pBack);
+		gameCopyRows(
+			g_pGameBufferMain->pBack, 0, g_pGameBufferMain->pFront, 0,
+			g_pGameBufferMain->pBack->Rows
+		);
+#if defined(ACE_BOB_PRISTINE_BUFFER)
+		gameCopyRows(
+			g_pGameBufferMain->pBack, 0, g_pGamePristineBuffer, 0,
+			g_pGameBufferMain->pBack->Rows
+		);
+#endif
+	}
+#endif
+#if defined(GAME_DEBUG)
+	blitWait();
+	char szMapTime[15];
+	timerFormatPrec(szMapTime, timerGetDelta(ulMapStart, timerGetPrec()));
+#if defined(GAME_BG_RING_BUFFER) || defined(GAME_MAP_GENERATE_PER_TILE)
+	logWrite("Map generated in %s\n", szMapTime);
+#else
+	logWrite(
+		"Map generated in %s by %s\n", szMapTime,
+		s_isMapComposedByCpu ? "CPU" : "blitter"
+	);
+#endif
+#endif
 
 	s_ubDeathCooldown = GAME_PLAYER_DEATH_COOLDOWN;
 	gameSetCursor(CURSOR_KIND_FULL);
@@ -1687,6 +2842,7 @@ void gameStart(void) {
 
 	s_ulKills = 0;
 	s_ulScore = 0;
+	scoreBcdReset();
 	s_ulPrevLevelScore = 0;
 	s_ulNextLevelScore = 1024;
 	s_ubScoreLevel = 1;
@@ -1715,9 +2871,9 @@ void gameStart(void) {
 
 	hudReset();
 
-	for(UBYTE ubX = 0; ubX < COLLISION_LOOKUP_SIZE_X; ++ubX) {
-		for(UBYTE ubY = 0; ubY < COLLISION_LOOKUP_SIZE_Y; ++ubY) {
-			s_pCollisionTiles[ubX][ubY] = 0;
+	for(UWORD uwX = 0; uwX < COLLISION_LOOKUP_SIZE_X; ++uwX) {
+		for(UWORD uwY = 0; uwY < COLLISION_LOOKUP_SIZE_Y; ++uwY) {
+			s_pCollisionTiles[uwX][uwY] = 0;
 		}
 	}
 
@@ -1752,6 +2908,7 @@ void gameStart(void) {
 	s_sPickup.eKind = ENTITY_KIND_PICKUP;
 	s_sPickup.wHealth = 0;
 	s_sPickup.sPos.ulYX = 0;
+	s_isPickupDrawPending = 0;
 	s_pSortedEntities[ubSorted++] = &s_sPickup;
 
 	s_ubExplosionCooldown = 0;
@@ -1763,7 +2920,15 @@ void gameStart(void) {
 	}
 	s_ubFreeProjectileCount = PROJECTILE_COUNT;
 	s_ulFrameCount = 0;
+	blitHogReset(&s_ulFrameCount);
 	s_ulFrameWaitCount = 1;
+#if defined(GAME_BG_RING_BUFFER)
+	cameraCenterAtOptimized(
+		g_pGameBufferMain->pCamera, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY
+	);
+	s_uwBufferUnwrapY = g_pGameBufferMain->pCamera->uPos.uwY;
+	s_isBufferUnwrapped = 1;
+#endif
 	gameResume();
 
 	ptplayerLoadMod(g_pModGame, g_pModSamples, 0);
@@ -1774,6 +2939,7 @@ __attribute__((always_inline))
 static inline void detonateBombAtPlayer(void) {
 	s_sExplosionBob.sPos.uwX = s_sPlayer.sPos.uwX - EXPLOSION_BOB_SIZE_X / 2;
 	s_sExplosionBob.sPos.uwY = s_sPlayer.sPos.uwY - EXPLOSION_BOB_SIZE_Y / 2;
+	s_ubExplosionTrimTop = 0;
 	s_ubExplosionCooldown = 1;
 	s_ubExplosionFrame = -1;
 	for(UBYTE i = 0; i < SORTED_ENTITIES_COUNT; ++i) {
@@ -1790,13 +2956,13 @@ static inline void detonateBombAtPlayer(void) {
 		}
 	}
 
-	audioMixerPlaySfx(g_pSfxExplosion, SFX_CHANNEL_EXPLOSION, SFX_PRIORITY_EXPLOSION, 0);
+	sfxQueueAdd(g_pSfxExplosion, SFX_CHANNEL_EXPLOSION, SFX_PRIORITY_EXPLOSION, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 }
 
 __attribute__((always_inline))
 static inline void playerApplyPickup(tPickupKind ePickupKind) {
 	if(s_isBonusLearner) {
-		scoreAddSmall(100);
+		scoreAddSmall(100, 0x100);
 	}
 
 	switch(ePickupKind) {
@@ -1816,10 +2982,10 @@ static inline void playerApplyPickup(tPickupKind ePickupKind) {
 			playerSetWeapon(WEAPON_KIND_SAWOFF);
 			break;
 		case PICKUP_KIND_EXP_400:
-			scoreAddSmall(400);
+			scoreAddSmall(400, 0x400);
 			break;
 		case PICKUP_KIND_EXP_800:
-			scoreAddSmall(800);
+			scoreAddSmall(800, 0x800);
 			break;
 		case PICKUP_KIND_BOMB:
 			detonateBombAtPlayer();
@@ -1833,7 +2999,11 @@ __attribute__((always_inline))
 static inline UBYTE playerProcess(void) {
 	if(mouseUse(MOUSE_PORT_1, MOUSE_RMB) && s_ubPendingPerks) {
 		systemSetInt(INTB_VERTB, 0, 0);
+		spriteMuxHide();
 		gameSetCursor(CURSOR_KIND_FULL);
+		sfxSequenceStop(SFX_CHANNEL_RELOAD);
+		// Requests of this frame would be played on resume otherwise
+		sfxQueueReset(&g_pGameBufferMain->pCamera->uPos);
 		statePush(g_pGameStateManager, &g_sStatePerks);
 		return 1;
 	}
@@ -1905,19 +3075,10 @@ static inline UBYTE playerProcess(void) {
 
 		if(s_sPlayer.sPlayer.bReloadCooldown) {
 			if(!s_isFinalReloadSfxPlayed && s_sPlayer.sPlayer.bReloadCooldown <= s_ubReloadFinalLength) {
-				audioMixerPlaySfx(g_pSfxReloadFinal, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, 0);
+				sfxSequenceStop(SFX_CHANNEL_RELOAD);
+				sfxQueueAdd(g_pSfxReloadFinal, SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 				s_isFinalReloadSfxPlayed = 1;
 			}
-			else if(audioMixerIsPlaybackDone(SFX_CHANNEL_RELOAD)) {
-				if(s_ubReloadClickCooldown <= 0) {
-					s_ubReloadClickCooldown = RELOAD_CLICK_COOLDOWN;
-					audioMixerPlaySfx(g_pSfxReloadClicks[s_ubReloadClickIndex], SFX_CHANNEL_RELOAD, SFX_PRIORITY_RELOAD, 0);
-					s_ubReloadClickIndex ^= 1;
-				}
-				else {
-					--s_ubReloadClickCooldown;
-				}
-			}
 
 			--s_sPlayer.sPlayer.bReloadCooldown;
 			if(s_isAnxiousLoader && mouseUse(MOUSE_PORT_1, MOUSE_LMB)) {
@@ -1977,15 +3138,14 @@ static inline UBYTE playerProcess(void) {
 		}
 		s_sPlayer.sPlayer.eDirection = eDir;
 		tFrameOffset *pOffset = &s_pPlayerFrameOffsets[eDir][s_sPlayer.eFrame];
+		bobSetFrameTrimmed(
+			&s_sPlayer.sBob, &s_sPlayer.ubBobTrimTop, pOffset,
+			s_sPlayer.sPos.uwX - PLAYER_BOB_OFFSET_X, s_sPlayer.sPos.uwY - PLAYER_BOB_OFFSET_Y
+		);
 		if(s_sPlayer.sPlayer.ubBlinkCooldown) {
 			--s_sPlayer.sPlayer.ubBlinkCooldown;
+			s_sPlayer.sBob.pFrameData = playerGetBlinkData();
 		}
-		else {
-			s_sPlayer.sBob.pFrameData = pOffset->pPixels;
-		}
-		s_sPlayer.sBob.pMaskData = pOffset->pMask;
-		s_sPlayer.sBob.sPos.uwX = s_sPlayer.sPos.uwX - PLAYER_BOB_OFFSET_X;
-		s_sPlayer.sBob.sPos.uwY = s_sPlayer.sPos.uwY - PLAYER_BOB_OFFSET_Y;
 		cameraCenterAtOptimized(g_pGameBufferMain->pCamera, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 
 		if(s_isDeathClock) {
@@ -2010,7 +3170,8 @@ static inline UBYTE playerProcess(void) {
 			if(s_isFinalRevenge) {
 				detonateBombAtPlayer();
 			}
-			audioMixerPlaySfx(g_pSfxDeath, SFX_CHANNEL_DEATH, SFX_PRIORITY_DEATH, 0);
+			sfxSequenceStop(SFX_CHANNEL_RELOAD);
+			sfxQueueAdd(g_pSfxDeath, SFX_CHANNEL_DEATH, SFX_PRIORITY_DEATH, s_sPlayer.sPos.uwX, s_sPlayer.sPos.uwY);
 		}
 		if(s_ubDeathCooldown) {
 			--s_ubDeathCooldown;
@@ -2026,12 +3187,16 @@ static inline UBYTE playerProcess(void) {
 				++s_sPlayer.sPlayer.ubFrameCooldown;
 			}
 			tFrameOffset *pOffset = &s_pPlayerFrameOffsets[s_sPlayer.sPlayer.eDirection][s_sPlayer.eFrame];
-			bobSetFrame(&s_sPlayer.sBob, pOffset->pPixels, pOffset->pMask);
-			s_sPlayer.sBob.sPos.uwX = s_sPlayer.sPos.uwX + s_pPlayerFrameDeathOffset[s_sPlayer.sPlayer.eDirection][s_sPlayer.eFrame - ENTITY_FRAME_DIE_1].bX;
-			s_sPlayer.sBob.sPos.uwY = s_sPlayer.sPos.uwY + s_pPlayerFrameDeathOffset[s_sPlayer.sPlayer.eDirection][s_sPlayer.eFrame - ENTITY_FRAME_DIE_1].bY;
+			const tBCoordYX *pDeathOffset = &s_pPlayerFrameDeathOffset[s_sPlayer.sPlayer.eDirection][s_sPlayer.eFrame - ENTITY_FRAME_DIE_1];
+			bobSetFrameTrimmed(
+				&s_sPlayer.sBob, &s_sPlayer.ubBobTrimTop, pOffset,
+				s_sPlayer.sPos.uwX + pDeathOffset->bX, s_sPlayer.sPos.uwY + pDeathOffset->bY
+			);
 			}
 		else {
 			gameSetCursor(CURSOR_KIND_FULL);
+			spriteMuxHide();
+			sfxQueueReset(&g_pGameBufferMain->pCamera->uPos);
 			menuPush(1);
 			return 1;
 		}
@@ -2044,7 +3209,7 @@ static inline UBYTE playerProcess(void) {
 
 __attribute__((always_inline))
 static inline void pickupSpawnRandom(void) {
-	tPickupKind ePickupKind = randUwMax(&g_sRand, PICKUP_KIND_COUNT - 1);
+	tPickupKind ePickupKind = gameRandUwMax(GAME_RAND_STREAM_PICKUPS, PICKUP_KIND_COUNT - 1);
 	if(s_isFavouriteWeapon && ePickupKind <= PICKUP_KIND_WEAPON_LAST) {
 		s_sPickup.wHealth = HEALTH_PICKUP_INACTIVE;
 		return;
@@ -2053,13 +3218,11 @@ static inline void pickupSpawnRandom(void) {
 	s_sPickup.wHealth = PICKUP_LIFE_SECONDS * GAME_FPS;
 	s_sPickup.sPickup.wBlinkCooldown = (PICKUP_LIFE_SECONDS - 3) * GAME_FPS;
 	s_sPickup.sPickup.isDisplayed = 1;
-	bobSetFrame(
-		&s_sPickup.sBob,
-		s_pPickupFrameOffsets[s_sPickup.sPickup.ePickupKind].pPixels,
-		s_pPickupFrameOffsets[s_sPickup.sPickup.ePickupKind].pMask
+	bobSetFrameTrimmed(
+		&s_sPickup.sBob, &s_sPickup.ubBobTrimTop,
+		&s_pPickupFrameOffsets[s_sPickup.sPickup.ePickupKind],
+		s_sPickup.sPos.uwX - PICKUP_BOB_OFFSET_X, s_sPickup.sPos.uwY - PICKUP_BOB_OFFSET_Y
 	);
-	s_sPickup.sBob.sPos.uwX = s_sPickup.sPos.uwX - PICKUP_BOB_OFFSET_X;
-	s_sPickup.sBob.sPos.uwY = s_sPickup.sPos.uwY - PICKUP_BOB_OFFSET_Y;
 	s_pCollisionTiles[s_sPickup.sPos.uwX / COLLISION_SIZE_X][s_sPickup.sPos.uwY / COLLISION_SIZE_Y] = &s_sPickup;
 }
 
@@ -2076,16 +3239,15 @@ static inline void pickupProcess(tEntity *pPickup) {
 				s_sPickup.sPickup.wBlinkCooldown = GAME_FPS / 5;
 				s_sPickup.sPickup.isDisplayed = !s_sPickup.sPickup.isDisplayed;
 			}
-			if(s_sPickup.sPickup.isDisplayed) {
-				bobPush(&pPickup->sBob);
-			}
+			// Pushed after camera is final, see pickupDraw()
+			s_isPickupDrawPending = s_sPickup.sPickup.isDisplayed;
 		}
 	}
 	else {
 		if(pPickup->wHealth == HEALTH_PICKUP_READY_TO_SPAWN) {
 			if(
 				s_sPlayer.sPlayer.eWeaponKind == WEAPON_KIND_STOCK_RIFLE ||
-				randUwMax(&g_sRand, PICKUP_SPAWN_CHANCE_MAX) < PICKUP_SPAWN_CHANCE
+				gameRandUwMax(GAME_RAND_STREAM_PICKUPS, PICKUP_SPAWN_CHANCE_MAX) < PICKUP_SPAWN_CHANCE
 			) {
 				pickupSpawnRandom();
 			}
@@ -2100,6 +3262,24 @@ static inline void pickupProcess(tEntity *pPickup) {
 	}
 }
 
+__attribute__((always_inline))
+static inline void pickupDraw(void) {
+	if(!s_isPickupDrawPending) {
+		return;
+	}
+	s_isPickupDrawPending = 0;
+
+	const tUwCoordYX *pCamPos = &g_pGameBufferMain->pCamera->uPos;
+	if(!spriteMuxPush(
+		&s_pPickupSpriteFrames[s_sPickup.sPickup.ePickupKind],
+		s_sPickup.sPos.uwX - PICKUP_BOB_OFFSET_X - pCamPos->uwX,
+		s_sPickup.sPos.uwY - PICKUP_BOB_OFFSET_Y - pCamPos->uwY
+	)) {
+		// No free sprite channel or partially off-screen - out of Y order, but rare
+		bobPushCulled(&s_sPickup.sBob);
+	}
+}
+
 __attribute__((always_inline))
 static inline void explosionProcess(void) {
 	if(s_ubExplosionFrame != EXPLOSION_FRAME_COUNT) {
@@ -2108,13 +3288,12 @@ static inline void explosionProcess(void) {
 			if(++s_ubExplosionFrame == EXPLOSION_FRAME_COUNT) {
 				return;
 			}
-			bobSetFrame(
-				&s_sExplosionBob,
-				s_pExplosionFrameOffsets[s_ubExplosionFrame].pPixels,
-				s_pExplosionFrameOffsets[s_ubExplosionFrame].pMask
+			bobChangeFrameTrimmed(
+				&s_sExplosionBob, &s_ubExplosionTrimTop,
+				&s_pExplosionFrameOffsets[s_ubExplosionFrame]
 			);
 		}
-		bobPush(&s_sExplosionBob);
+		bobPushCulled(&s_sExplosionBob);
 	}
 }
 
@@ -2122,17 +3301,47 @@ static inline void explosionProcess(void) {
 
 static void gameGsCreate(void) {
 	logBlockBegin("gameGsCreate()");
-	s_pTileset = bitmapCreateFromPath("data/tiles.bm", 0);
-	s_pHudWeapons = bitmapCreateFromPath("data/weapons.bm", 0);
-	s_pHudLevelUp = bitmapCreateFromPath("data/level_up.bm", 0);
+	s_pTileset = assetArchiveBitmapCreate("tiles.bm");
+	s_pHudWeapons = assetArchiveBitmapCreate("weapons.bm");
+	s_pHudLevelUp = assetArchiveBitmapCreate("level_up.bm");
 	assetsGameCreate();
+	sfxSequenceCreate();
+	for(UBYTE i = 0; i < 2; ++i) {
+		s_pReloadClickSteps[i] = (tSfxSequenceStep){
+			.pSfx = g_pSfxReloadClicks[i],
+			.uwGapLength = SFX_SEQUENCE_GAP_FROM_MS(RELOAD_CLICK_GAP_MS)
+		};
+	}
+
+	// Score digits drawn in HUD colors once, so that score update is only
+	// a blit of changed cells.
+	UWORD uwDigitsHeight = g_pFontSmall->uwHeight * (HUD_SCORE_DIGIT_BLANK + 1);
+	s_pBmHudDigits = bitmapCreate(
+		16, uwDigitsHeight, GAME_HUD_BPP, BMF_INTERLEAVED
+	);
+	blitRect(
+		s_pBmHudDigits, 0, 0, HUD_SCORE_DIGIT_CELL_X, uwDigitsHeight, COLOR_HUD_BG
+	);
+	for(UBYTE ubDigit = 0; ubDigit < HUD_SCORE_DIGIT_BLANK; ++ubDigit) {
+		char szDigit[2] = {'0' + ubDigit, '\0'};
+		fontFillTextBitMap(g_pFontSmall, g_pLineBuffer, szDigit);
+		fontDrawTextBitMap(
+			s_pBmHudDigits, g_pLineBuffer, 0, ubDigit * g_pFontSmall->uwHeight,
+			COLOR_HUD_DIGITS & ~COLOR_HUD_BAR_BG, FONT_COOKIE | FONT_LAZY
+		);
+	}
 
 	ULONG ulRawCopSize = (
+#if defined(GAME_BG_RING_BUFFER)
+		16 + BG_RING_COP_CMD_COUNT +
+#else
 		16 + simpleBufferGetRawCopperlistInstructionCount(GAME_BPP) +
+#endif
 		simpleBufferGetRawCopperlistInstructionCount(GAME_HUD_BPP) +
 		1 + GAME_HUD_PALETTE_COLORS + // HUD: move bpp + initial color moves
 		2 * (1 + 1) * 2 + // 2x Bars: wait + color move; + 2x their shadows
-		2 + GAME_HUD_PALETTE_COLORS // MAIN: wait + move bpp + final color moves
+		2 + GAME_HUD_PALETTE_COLORS + // MAIN: wait + move bpp + final color moves
+		BLIT_QUEUE_COP_CMD_COUNT
 	);
 	s_pView = viewCreate(0,
 		TAG_VIEW_COPLIST_MODE, VIEW_COPLIST_MODE_RAW,
@@ -2144,11 +3353,14 @@ static void gameGsCreate(void) {
 		TAG_VPORT_HEIGHT, GAME_HUD_VPORT_SIZE_Y,
 		TAG_VPORT_VIEW, s_pView,
 	TAG_END);
-	paletteLoadFromPath("data/hud.plt", s_pVpHud->pPalette, 1 << GAME_HUD_BPP);
+	paletteLoadFromFd(assetArchiveOpen("hud.plt", 0), s_pVpHud->pPalette, 1 << GAME_HUD_BPP);
 	s_pVpHud->pPalette[8] = 0xE72;
 
 	ULONG ulCopOffset = 16;
 
+	blitQueueCreate(s_pView, ulCopOffset);
+	ulCopOffset += BLIT_QUEUE_COP_CMD_COUNT;
+
 	copSetMove(&s_pView->pCopList->pFrontBfr->pList[ulCopOffset].sMove, &g_pCustom->bplcon0, BV(9) | (GAME_HUD_BPP << 12));
 	copSetMove(&s_pView->pCopList->pBackBfr->pList[ulCopOffset].sMove, &g_pCustom->bplcon0, BV(9) | (GAME_HUD_BPP << 12));
 	++ulCopOffset;
@@ -2199,7 +3411,7 @@ static void gameGsCreate(void) {
 		TAG_VPORT_VIEW, s_pView,
 		TAG_VPORT_BPP, GAME_BPP,
 	TAG_END);
-	paletteLoadFromPath("data/game.plt", s_pVpMain->pPalette, 1 << GAME_BPP);
+	paletteLoadFromFd(assetArchiveOpen("game.plt", 0), s_pVpMain->pPalette, 1 << GAME_BPP);
 
 	copSetWait(&s_pView->pCopList->pFrontBfr->pList[ulCopOffset].sWait, 0xAE, s_pView->ubPosY + GAME_HUD_VPORT_SIZE_Y - 1);
 	copSetWait(&s_pView->pCopList->pBackBfr->pList[ulCopOffset].sWait, 0xAE, s_pView->ubPosY + GAME_HUD_VPORT_SIZE_Y - 1);
@@ -2213,6 +3425,13 @@ static void gameGsCreate(void) {
 		++ulCopOffset;
 	}
 
+#if defined(GAME_DEBUG)
+	// Main buffers & bg restore, i.e. pristine buffer or decals & bob bg saves
+	ULONG ulChipFree = memGetFreeChipSize();
+#endif
+#if defined(GAME_BG_RING_BUFFER)
+	g_pGameBufferMain = gameBufferCreate(s_pVpMain, ulCopOffset);
+#else
 	g_pGameBufferMain = simpleBufferCreate(0,
 		TAG_SIMPLEBUFFER_BITMAP_FLAGS, BMF_INTERLEAVED,
 		TAG_SIMPLEBUFFER_BOUND_WIDTH, MAP_TILES_X * MAP_TILE_SIZE,
@@ -2221,6 +3440,7 @@ static void gameGsCreate(void) {
 		TAG_SIMPLEBUFFER_VPORT, s_pVpMain,
 		TAG_SIMPLEBUFFER_COPLIST_OFFSET, ulCopOffset,
 	TAG_END);
+#endif
 	copSetMove(&s_pView->pCopList->pFrontBfr->pList[ulCopOffset].sMove, &g_pCustom->bplcon0, BV(9) | (GAME_BPP << 12));
 	copSetMove(&s_pView->pCopList->pBackBfr->pList[ulCopOffset].sMove, &g_pCustom->bplcon0, BV(9) | (GAME_BPP << 12));
 
@@ -2230,34 +3450,43 @@ static void gameGsCreate(void) {
 		MAP_TILES_Y * MAP_TILE_SIZE / 2
 	);
 
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	g_pGamePristineBuffer = bitmapCreate(
 		bitmapGetByteWidth(g_pGameBufferMain->pBack) * 8,
 		g_pGameBufferMain->pBack->Rows, GAME_BPP, BMF_INTERLEAVED
 	);
 	s_pPristinePlanes = g_pGamePristineBuffer->Planes[0];
+#else
+	s_pBgDecals = bitmapCreate(
+		BG_TILE_SIZE, BG_TILE_SIZE * BG_DECAL_TILES_MAX, GAME_BPP, BMF_INTERLEAVED
+	);
+#endif
+#if defined(GAME_DEBUG)
+	s_ulPlayfieldChipBytes = ulChipFree - memGetFreeChipSize();
+#endif
 
-	randInit(&g_sRand, 2184, 1911);
-
-	for(UWORD uwY = 0; uwY < MAP_TILES_Y * MAP_TILE_SIZE; ++uwY) {
-		s_pRowOffsetFromY[uwY] = uwY * BG_BYTES_PER_PIXEL_ROW;
-	}
+	gameRandSeed(GAME_RAND_DEFAULT_SEED);
+#if !defined(GAME_BG_RING_BUFFER) && !defined(GAME_MAP_GENERATE_PER_TILE)
+	s_isMapComposedByCpu = (SysBase->AttnFlags & AFF_68020) != 0;
+	logWrite("Map composed by %s\n", s_isMapComposedByCpu ? "CPU" : "blitter");
+#endif
 
 	s_ubBufferCurr = 0;
 
 	// Frames
-	s_pPlayerFrames[DIRECTION_NE] = bitmapCreateFromPath("data/player_ne.bm", 0);
-	s_pPlayerFrames[DIRECTION_N] = bitmapCreateFromPath("data/player_n.bm", 0);
-	s_pPlayerFrames[DIRECTION_NW] = bitmapCreateFromPath("data/player_nw.bm", 0);
-	s_pPlayerFrames[DIRECTION_SW] = bitmapCreateFromPath("data/player_sw.bm", 0);
-	s_pPlayerFrames[DIRECTION_S] = bitmapCreateFromPath("data/player_s.bm", 0);
-	s_pPlayerFrames[DIRECTION_SE] = bitmapCreateFromPath("data/player_se.bm", 0);
-
-	s_pPlayerMasks[DIRECTION_NE] = bitmapCreateFromPath("data/player_ne_mask.bm", 0);
-	s_pPlayerMasks[DIRECTION_N] = bitmapCreateFromPath("data/player_n_mask.bm", 0);
-	s_pPlayerMasks[DIRECTION_NW] = bitmapCreateFromPath("data/player_nw_mask.bm", 0);
-	s_pPlayerMasks[DIRECTION_SW] = bitmapCreateFromPath("data/player_sw_mask.bm", 0);
-	s_pPlayerMasks[DIRECTION_S] = bitmapCreateFromPath("data/player_s_mask.bm", 0);
-	s_pPlayerMasks[DIRECTION_SE] = bitmapCreateFromPath("data/player_se_mask.bm", 0);
+	s_pPlayerFrames[DIRECTION_NE] = assetArchiveBitmapCreate("player_ne.bm");
+	s_pPlayerFrames[DIRECTION_N] = assetArchiveBitmapCreate("player_n.bm");
+	s_pPlayerFrames[DIRECTION_NW] = assetArchiveBitmapCreate("player_nw.bm");
+	s_pPlayerFrames[DIRECTION_SW] = assetArchiveBitmapCreate("player_sw.bm");
+	s_pPlayerFrames[DIRECTION_S] = assetArchiveBitmapCreate("player_s.bm");
+	s_pPlayerFrames[DIRECTION_SE] = assetArchiveBitmapCreate("player_se.bm");
+
+	s_pPlayerMasks[DIRECTION_NE] = maskCreate("player_ne_mask.bm", GAME_BPP);
+	s_pPlayerMasks[DIRECTION_N] = maskCreate("player_n_mask.bm", GAME_BPP);
+	s_pPlayerMasks[DIRECTION_NW] = maskCreate("player_nw_mask.bm", GAME_BPP);
+	s_pPlayerMasks[DIRECTION_SW] = maskCreate("player_sw_mask.bm", GAME_BPP);
+	s_pPlayerMasks[DIRECTION_S] = maskCreate("player_s_mask.bm", GAME_BPP);
+	s_pPlayerMasks[DIRECTION_SE] = maskCreate("player_se_mask.bm", GAME_BPP);
 
 	s_pPlayerBlinkBitmaps[BLINK_KIND_HURT] = bitmapCreate(PLAYER_BOB_SIZE_X, PLAYER_BOB_SIZE_Y, GAME_BPP, BMF_INTERLEAVED);
 	s_pPlayerBlinkBitmaps[BLINK_KIND_LEVEL] = bitmapCreate(PLAYER_BOB_SIZE_X, PLAYER_BOB_SIZE_Y, GAME_BPP, BMF_INTERLEAVED);
@@ -2268,8 +3497,10 @@ static void gameGsCreate(void) {
 
 	for(tDirection eDir = 0; eDir < DIRECTION_COUNT; ++eDir) {
 		for(tCharacterFrame eFrame = 0; eFrame < ENTITY_FRAME_COUNT; ++eFrame) {
-			s_pPlayerFrameOffsets[eDir][eFrame].pPixels = bobCalcFrameAddress(s_pPlayerFrames[eDir], eFrame * PLAYER_BOB_SIZE_Y);
-			s_pPlayerFrameOffsets[eDir][eFrame].pMask = bobCalcFrameAddress(s_pPlayerMasks[eDir], eFrame * PLAYER_BOB_SIZE_Y);
+			frameOffsetInit(
+				&s_pPlayerFrameOffsets[eDir][eFrame], s_pPlayerFrames[eDir],
+				s_pPlayerMasks[eDir], eFrame * PLAYER_BOB_SIZE_Y, PLAYER_BOB_SIZE_Y
+			);
 
 #if defined(GAME_COLLISION_DEBUG)
 			blitRect(
@@ -2281,24 +3512,26 @@ static void gameGsCreate(void) {
 		}
 	}
 
-	s_pEnemyFrames[DIRECTION_NE] = bitmapCreateFromPath("data/zombie_ne.bm", 0);
-	s_pEnemyFrames[DIRECTION_N] = bitmapCreateFromPath("data/zombie_n.bm", 0);
-	s_pEnemyFrames[DIRECTION_NW] = bitmapCreateFromPath("data/zombie_nw.bm", 0);
-	s_pEnemyFrames[DIRECTION_SW] = bitmapCreateFromPath("data/zombie_sw.bm", 0);
-	s_pEnemyFrames[DIRECTION_S] = bitmapCreateFromPath("data/zombie_s.bm", 0);
-	s_pEnemyFrames[DIRECTION_SE] = bitmapCreateFromPath("data/zombie_se.bm", 0);
+	s_pEnemyFrames[DIRECTION_NE] = assetArchiveBitmapCreate("zombie_ne.bm");
+	s_pEnemyFrames[DIRECTION_N] = assetArchiveBitmapCreate("zombie_n.bm");
+	s_pEnemyFrames[DIRECTION_NW] = assetArchiveBitmapCreate("zombie_nw.bm");
+	s_pEnemyFrames[DIRECTION_SW] = assetArchiveBitmapCreate("zombie_sw.bm");
+	s_pEnemyFrames[DIRECTION_S] = assetArchiveBitmapCreate("zombie_s.bm");
+	s_pEnemyFrames[DIRECTION_SE] = assetArchiveBitmapCreate("zombie_se.bm");
 
-	s_pEnemyMasks[DIRECTION_NE] = bitmapCreateFromPath("data/zombie_ne_mask.bm", 0);
-	s_pEnemyMasks[DIRECTION_N] = bitmapCreateFromPath("data/zombie_n_mask.bm", 0);
-	s_pEnemyMasks[DIRECTION_NW] = bitmapCreateFromPath("data/zombie_nw_mask.bm", 0);
-	s_pEnemyMasks[DIRECTION_SW] = bitmapCreateFromPath("data/zombie_sw_mask.bm", 0);
-	s_pEnemyMasks[DIRECTION_S] = bitmapCreateFromPath("data/zombie_s_mask.bm", 0);
-	s_pEnemyMasks[DIRECTION_SE] = bitmapCreateFromPath("data/zombie_se_mask.bm", 0);
+	s_pEnemyMasks[DIRECTION_NE] = maskCreate("zombie_ne_mask.bm", GAME_BPP);
+	s_pEnemyMasks[DIRECTION_N] = maskCreate("zombie_n_mask.bm", GAME_BPP);
+	s_pEnemyMasks[DIRECTION_NW] = maskCreate("zombie_nw_mask.bm", GAME_BPP);
+	s_pEnemyMasks[DIRECTION_SW] = maskCreate("zombie_sw_mask.bm", GAME_BPP);
+	s_pEnemyMasks[DIRECTION_S] = maskCreate("zombie_s_mask.bm", GAME_BPP);
+	s_pEnemyMasks[DIRECTION_SE] = maskCreate("zombie_se_mask.bm", GAME_BPP);
 
 	for(tDirection eDir = 0; eDir < DIRECTION_COUNT; ++eDir) {
 		for(tCharacterFrame eFrame = 0; eFrame < ENEMY_FRAME_COUNT; ++eFrame) {
-			s_pEnemyFrameOffsets[eDir][eFrame].pPixels = bobCalcFrameAddress(s_pEnemyFrames[eDir], eFrame * ENEMY_BOB_SIZE_Y);
-			s_pEnemyFrameOffsets[eDir][eFrame].pMask = bobCalcFrameAddress(s_pEnemyMasks[eDir], eFrame * ENEMY_BOB_SIZE_Y);
+			frameOffsetInit(
+				&s_pEnemyFrameOffsets[eDir][eFrame], s_pEnemyFrames[eDir],
+				s_pEnemyMasks[eDir], eFrame * ENEMY_BOB_SIZE_Y, ENEMY_BOB_SIZE_Y
+			);
 
 #if defined(GAME_COLLISION_DEBUG)
 			blitRect(
@@ -2310,15 +3543,21 @@ static void gameGsCreate(void) {
 		}
 	}
 
-	s_pPickupFrames = bitmapCreateFromPath("data/pickups.bm", 0);
-	s_pPickupMasks = bitmapCreateFromPath("data/pickups_mask.bm", 0);
+	s_pPickupFrames = assetArchiveBitmapCreate("pickups.bm");
+	s_pPickupMasks = maskCreate("pickups_mask.bm", GAME_BPP);
 	for(UBYTE i = 0; i < PICKUP_KIND_COUNT; ++i) {
-		s_pPickupFrameOffsets[i].pPixels = bobCalcFrameAddress(s_pPickupFrames, i * PICKUP_BOB_SIZE_Y);
-		s_pPickupFrameOffsets[i].pMask = bobCalcFrameAddress(s_pPickupMasks, i * PICKUP_BOB_SIZE_Y);
+		frameOffsetInit(
+			&s_pPickupFrameOffsets[i], s_pPickupFrames, s_pPickupMasks,
+			i * PICKUP_BOB_SIZE_Y, PICKUP_BOB_SIZE_Y
+		);
+		spriteMuxFrameCreate(
+			&s_pPickupSpriteFrames[i], s_pPickupFrames, s_pPickupMasks,
+			i * PICKUP_BOB_SIZE_Y, PICKUP_BOB_SIZE_Y, s_pVpMain->pPalette
+		);
 	}
 
-	s_pBulletFrames = bitmapCreateFromPath("data/bullets.bm", 0);
-	s_pBulletMasks = bitmapCreateFromPath("data/bullets_mask.bm", 0);
+	s_pBulletFrames = assetArchiveBitmapCreate("bullets.bm");
+	s_pBulletMasks = maskCreate("bullets_mask.bm", s_pBulletFrames->Depth);
 	for(UBYTE i = 0; i < WEAPON_MAX_BULLETS_IN_MAGAZINE; ++i) {
 		s_pHudBulletDefs[i] = (tHudBulletDef){
 			.sOffs = {
@@ -2329,105 +3568,90 @@ static void gameGsCreate(void) {
 		};
 	}
 
-	s_pExplosionFrames = bitmapCreateFromPath("data/explosion.bm", 0);
-	s_pExplosionMasks = bitmapCreateFromPath("data/explosion_mask.bm", 0);
+	s_pExplosionFrames = assetArchiveBitmapCreate("explosion.bm");
+	s_pExplosionMasks = maskCreate("explosion_mask.bm", GAME_BPP);
 	for(UBYTE i = 0; i < EXPLOSION_FRAME_COUNT; ++i) {
-		s_pExplosionFrameOffsets[i].pPixels = bobCalcFrameAddress(s_pExplosionFrames, i * EXPLOSION_BOB_SIZE_Y);
-		s_pExplosionFrameOffsets[i].pMask = bobCalcFrameAddress(s_pExplosionMasks, i * EXPLOSION_BOB_SIZE_Y);
+		frameOffsetInit(
+			&s_pExplosionFrameOffsets[i], s_pExplosionFrames, s_pExplosionMasks,
+			i * EXPLOSION_BOB_SIZE_Y, EXPLOSION_BOB_SIZE_Y
+		);
 	}
 
-	s_pStainFrames = bitmapCreateFromPath("data/stains.bm", 0);
-	s_pStainMasks = bitmapCreateFromPath("data/stains_mask.bm", 0);
-
-	for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
-		s_pSpreadSide1[i] = - 2/2 + randUwMax(&g_sRand, 2);
-	}
-	for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
-		s_pSpreadSide2[i] = - 4/2 + randUwMax(&g_sRand, 4);
-	}
-	for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
-		s_pSpreadSide3[i] = - 6/2 + randUwMax(&g_sRand, 6);
-	}
-	for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
-		s_pSpreadSide10[i] = - 20/2 + randUwMax(&g_sRand, 20);
-	}
+	s_pStainFrames = assetArchiveBitmapCreate("stains.bm");
+#if defined(GAME_SINGLE_PLANE_STAIN_MASKS)
+	s_pStainMasks = maskCreate("stains_mask.bm", 1);
+#else
+	s_pStainMasks = maskCreate("stains_mask.bm", GAME_BPP);
+#endif
 
 	bobManagerCreate(
 		g_pGameBufferMain->pFront, g_pGameBufferMain->pBack,
-		g_pGamePristineBuffer, MAP_TILES_Y * MAP_TILE_SIZE
+#if defined(ACE_BOB_PRISTINE_BUFFER)
+		g_pGamePristineBuffer,
+#endif
+#if defined(GAME_BG_RING_BUFFER)
+		BG_RING_SIZE_Y
+#else
+		MAP_TILES_Y * MAP_TILE_SIZE
+#endif
 	);
 
 	for(UBYTE i = 0; i < STAIN_FRAME_PRESET_COUNT; ++i) {
-		UWORD uwOffsY = STAIN_SIZE_Y * randUwMax(&g_sRand, STAIN_FRAME_COUNT - 1);
+		UWORD uwOffsY = STAIN_SIZE_Y * gameRandUwMax(GAME_RAND_STREAM_STAINS, STAIN_FRAME_COUNT - 1);
 		s_pStainFrameOffsets[i].pPixels = bobCalcFrameAddress(s_pStainFrames, uwOffsY);
 		s_pStainFrameOffsets[i].pMask = bobCalcFrameAddress(s_pStainMasks, uwOffsY);
 	}
 	s_pNextStainOffset = &s_pStainFrameOffsets[0];
 
-	for(UBYTE i = 0; i < STAINS_MAX; ++i) {
-		bobInit(&s_pStainBobs[i], STAIN_SIZE_X, STAIN_SIZE_Y, 1, 0, 0, 0, 0);
-		s_pFreeStains[i] = &s_pStainBobs[i];
-	}
 	bobInit(&s_sExplosionBob, EXPLOSION_BOB_SIZE_X, EXPLOSION_BOB_SIZE_Y, 1, 0, 0, 0, 0);
-	s_pNextFreeStain = &s_pFreeStains[STAINS_MAX];
-	s_pNextPushStain = &s_pPushStains[0];
-	s_pNextWaitStain = &s_pWaitStains[0];
+	s_pExplosionDrawnHeights[0] = EXPLOSION_BOB_SIZE_Y;
+	s_pExplosionDrawnHeights[1] = EXPLOSION_BOB_SIZE_Y;
 
 	bobInit(&s_sPlayer.sBob, PLAYER_BOB_SIZE_X, PLAYER_BOB_SIZE_Y, 1, s_pPlayerFrameOffsets[0][0].pPixels, s_pPlayerFrameOffsets[0][0].pMask, 32, 32);
+	s_sPlayer.pBobDrawnHeights[0] = PLAYER_BOB_SIZE_Y;
+	s_sPlayer.pBobDrawnHeights[1] = PLAYER_BOB_SIZE_Y;
 	for(UBYTE i = 0; i < ENEMY_COUNT; ++i) {
 		bobInit(&s_pEnemies[i].sBob, ENEMY_BOB_SIZE_X, ENEMY_BOB_SIZE_Y, 1, s_pEnemyFrameOffsets[0][0].pPixels, s_pEnemyFrameOffsets[0][0].pMask, 32, 32);
+		s_pEnemies[i].pBobDrawnHeights[0] = ENEMY_BOB_SIZE_Y;
+		s_pEnemies[i].pBobDrawnHeights[1] = ENEMY_BOB_SIZE_Y;
 	}
 
 	bobInit(&s_sPickup.sBob, PICKUP_BOB_SIZE_X, PICKUP_BOB_SIZE_Y, 1, 0, 0, 0, 0);
+	s_sPickup.pBobDrawnHeights[0] = PICKUP_BOB_SIZE_Y;
+	s_sPickup.pBobDrawnHeights[1] = PICKUP_BOB_SIZE_Y;
 
+#if defined(GAME_DEBUG)
+	ulChipFree = memGetFreeChipSize();
+#endif
 	bobReallocateBuffers();
-	gameMathInit();
-	for(UBYTE ubAngle = 0; ubAngle < GAME_MATH_ANGLE_COUNT; ++ubAngle) {
-		s_pSin10p6[ubAngle] = csin(ubAngle) >> 10;
-	}
-
-	for(UBYTE ubX = 0; ubX < COLLISION_LOOKUP_SIZE_X; ++ubX) {
-		for(UBYTE ubY = 0; ubY < COLLISION_LOOKUP_SIZE_Y; ++ubY) {
-			ULONG ulCenterX = ubX * COLLISION_SIZE_X;
-			ULONG ulCenterY = ubY * COLLISION_SIZE_Y;
-			LONG lLeft = ulCenterX - GAME_MAIN_VPORT_SIZE_X / 2;
-			LONG lTop = ulCenterY - (GAME_MAIN_VPORT_SIZE_Y - GAME_HUD_VPORT_SIZE_Y) / 2;
-			lLeft = CLAMP(lLeft, MAP_MARGIN_TILES * MAP_TILE_SIZE, (MAP_TILES_X - MAP_MARGIN_TILES) * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_X);
-			lTop = CLAMP(lTop, MAP_MARGIN_TILES * MAP_TILE_SIZE, (MAP_TILES_Y - MAP_MARGIN_TILES) * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_Y);
-
-			s_pRespawnSlots[ubX][ubY][0] = (tUwCoordYX) {
-				.uwX = CLAMP(lLeft - ENEMY_BOB_SIZE_X, ENEMY_BOB_SIZE_X, MAP_TILES_X * MAP_TILE_SIZE - ENEMY_BOB_SIZE_X),
-				.uwY = ulCenterY,
-			};
-			s_pRespawnSlots[ubX][ubY][1] = (tUwCoordYX) {
-				.uwX = CLAMP(lLeft + GAME_MAIN_VPORT_SIZE_X + ENEMY_BOB_SIZE_X, ENEMY_BOB_SIZE_X, MAP_TILES_X * MAP_TILE_SIZE - ENEMY_BOB_SIZE_X),
-				.uwY = ulCenterY,
-			};
-			s_pRespawnSlots[ubX][ubY][2] = (tUwCoordYX) {
-				.uwX = ulCenterX,
-				.uwY = CLAMP(lTop - ENEMY_BOB_SIZE_Y, ENEMY_BOB_SIZE_Y, MAP_TILES_Y * MAP_TILE_SIZE - ENEMY_BOB_SIZE_Y),
-			};
-			s_pRespawnSlots[ubX][ubY][3] = (tUwCoordYX) {
-				.uwX = ulCenterX,
-				.uwY = CLAMP(lTop + GAME_MAIN_VPORT_SIZE_Y + ENEMY_BOB_SIZE_Y, ENEMY_BOB_SIZE_Y, MAP_TILES_Y * MAP_TILE_SIZE - ENEMY_BOB_SIZE_Y),
-			};
-		}
-	}
+#if defined(GAME_DEBUG)
+	s_ulPlayfieldChipBytes += ulChipFree - memGetFreeChipSize();
+	logWrite("Playfield memory: %lu bytes CHIP\n", s_ulPlayfieldChipBytes);
+#endif
+	gameTablesInit();
+#if defined(GAME_MATH_BENCHMARK)
+	gameMathBenchmark();
+#endif
 
 	s_pBmCursor = bitmapCreate(CURSOR_SPRITE_SIZE_X, CURSOR_SPRITE_SIZE_Y, 2, BMF_INTERLEAVED | BMF_CLEAR);
-	s_pBmCursorFrames = bitmapCreateFromPath("data/cursors.bm", 0);
+	s_pBmCursorFrames = assetArchiveBitmapCreate("cursors.bm");
 	for(tCursorKind i = 0; i < CURSOR_KIND_COUNT; ++i) {
 		s_pCursorOffsets[i] = (ULONG*)bobCalcFrameAddress(s_pBmCursorFrames, i * CURSOR_SIZE);
 	}
 	s_pCursorData = &((ULONG*)s_pBmCursor->Planes[0])[1];
 	gameSetCursor(CURSOR_KIND_FULL);
-	spriteManagerCreate(s_pView, 0, 0);
+	spriteManagerCreate(s_pView, SPRITE_RAW_COP_POS, 0);
 	s_pSpriteCursor = spriteAdd(SPRITE_CHANNEL_CURSOR, s_pBmCursor);
+	spriteMuxCreate(
+		s_pView, SPRITE_RAW_COP_POS, s_pView->ubPosY + GAME_HUD_VPORT_SIZE_Y,
+		GAME_MAIN_VPORT_SIZE_Y
+	);
 	systemSetDmaBit(DMAB_SPRITE, 1);
 	mouseSetBounds(MOUSE_PORT_1, 0, GAME_HUD_VPORT_SIZE_Y, 320, 256);
 
 	hiScoreLoad();
 	commCreate();
+	assetArchivePrefetchEnd();
 
 	systemUnuse();
 	gameStart();
@@ -2447,10 +3671,47 @@ static void gameGsCreate(void) {
 	viewProcessManagers(s_pView);
 	copSwapBuffers();
 
+	blitQueueFence();
 	logBlockEnd("gameGsCreate()");
 	menuPush(0);
 }
 
+#if defined(MIXER_COUNTER)
+static void gameMixerProfileFrame(void) {
+	tAudioMixerProfile sProfile;
+	audioMixerProfileTake(&sProfile);
+	s_ulMixerInterrupts += sProfile.uwInterrupts;
+	s_ulMixerClocks += sProfile.ulClocks;
+	s_ulMixerFrameClocksMax = MAX(s_ulMixerFrameClocksMax, sProfile.ulClocks);
+	s_ulMixerIrqClocksMax = MAX(s_ulMixerIrqClocksMax, sProfile.ulWorstClocks);
+	if(++s_uwMixerFrames == MIXER_PROFILE_FRAMES_MAX) {
+		// Keep the totals from overflowing, averages stay the same
+		s_uwMixerFrames /= 2;
+		s_ulMixerInterrupts /= 2;
+		s_ulMixerClocks /= 2;
+	}
+}
+
+static void gameMixerProfileLog(void) {
+	if(!s_uwMixerFrames) {
+		return;
+	}
+	ULONG ulAvgClocks = s_ulMixerClocks / s_uwMixerFrames;
+	logWrite(
+		"Mixer (%hhu sw channels): avg %lu.%02lu interrupts, %lu lines, %lu cycles, "
+		"%lu%% of frame time; worst frame: %lu lines, worst interrupt: %lu lines\n",
+		audioMixerGetChannelCount(),
+		s_ulMixerInterrupts / s_uwMixerFrames,
+		(s_ulMixerInterrupts * 100 / s_uwMixerFrames) % 100,
+		ulAvgClocks / MIXER_PROFILE_CLOCKS_PER_LINE,
+		ulAvgClocks * 2,
+		ulAvgClocks * 100 / MIXER_PROFILE_CLOCKS_PER_GAME_FRAME,
+		s_ulMixerFrameClocksMax / MIXER_PROFILE_CLOCKS_PER_LINE,
+		s_ulMixerIrqClocksMax / MIXER_PROFILE_CLOCKS_PER_LINE
+	);
+}
+#endif
+
 __attribute__((always_inline))
 static inline void gameWaitForNextFrame(void) {
 	systemIdleBegin();
@@ -2461,26 +3722,51 @@ static inline void gameWaitForNextFrame(void) {
 }
 
 static void gameGsLoop(void) {
+	// Queued HUD & stain blits from previous frame must be done before
+	// bob manager or other states take over the blitter.
+	blitQueueFrameBegin();
 	if(keyUse(KEY_ESCAPE)) {
 		systemSetInt(INTB_VERTB, 0, 0);
+		spriteMuxHide();
 		gameSetCursor(CURSOR_KIND_FULL);
+		sfxSequenceStop(SFX_CHANNEL_RELOAD);
+		sfxQueueReset(&g_pGameBufferMain->pCamera->uPos);
 		statePush(g_pGameStateManager, &g_sStatePause);
 		return;
 	}
 #if defined(GAME_DEBUG)
 	if(keyUse(KEY_0)) {
-		scoreAddSmall(500);
+		scoreAddSmall(500, 0x500);
 	}
 #endif
 
 	s_pBackPlanes = g_pGameBufferMain->pBack->Planes[0];
 	s_pCurrentProjectile = &s_pProjectiles[0];
+	blitHogPhaseBegin(BLIT_HOG_PHASE_UNDRAW);
+	bobsSwapDrawnHeights();
 	bobBegin(g_pGameBufferMain->pBack);
-	g_pCustom->dmacon = DMAF_BLITHOG;
+	bobsSwapDrawnHeights();
+#if defined(GAME_DEBUG)
+	s_uwBobsCulledMax = MAX(s_uwBobsCulledMax, s_uwBobsCulled);
+	s_ulBobsCulledTotal += s_uwBobsCulled;
+#endif
+	s_uwBobsCulled = 0;
 
 	while(s_pCurrentProjectile != &s_pProjectiles[PROJECTILE_COUNT]) {
 		projectileUndrawNext();
 	}
+#if defined(GAME_BG_RING_BUFFER)
+	gameBufferRefill(
+		g_pGameBufferMain->pBack, &g_pGameBufferMain->ubBackTileTop,
+		&g_pGameBufferMain->ubBackTileBottom
+	);
+	s_uwBgRowsTop = g_pGameBufferMain->ubBackTileTop << BG_TILE_SHIFT;
+	s_uwBgRowsHeight = (
+		g_pGameBufferMain->ubBackTileBottom - g_pGameBufferMain->ubBackTileTop + 1
+	) << BG_TILE_SHIFT;
+#endif
+	blitHogPhaseBegin(BLIT_HOG_PHASE_DRAW);
+	stainsProcessUndrawn();
 
 	tEntity **pPrev = &s_pSortedEntities[0];
 	for(UBYTE i = 0; i < SORTED_ENTITIES_COUNT; ++i) {
@@ -2506,6 +3792,9 @@ static void gameGsLoop(void) {
 		pPrev = &s_pSortedEntities[i];
 	}
 
+	spriteMuxBegin();
+	pickupDraw();
+	spriteMuxEnd();
 	explosionProcess();
 
 	s_pCurrentProjectile = &s_pProjectiles[0];
@@ -2514,41 +3803,58 @@ static void gameGsLoop(void) {
 		projectileDrawNext();
 	}
 
-	if(s_pNextWaitStain != &s_pWaitStains[0]) {
-		tBob *pStain = *(--s_pNextWaitStain);
-		*(s_pNextFreeStain++) = pStain;
-	}
-
-	if(s_pNextPushStain != &s_pPushStains[0]) {
-		tBob *pStain = *(--s_pNextPushStain);
-		blitUnsafeCopyStain(
-			s_pNextStainOffset->pPixels, s_pNextStainOffset->pMask,
-			pStain->sPos.uwX, pStain->sPos.uwY
-		);
-		bobForceUndraw(pStain);
-		*(s_pNextWaitStain++) = pStain;
-		if(++s_pNextStainOffset == &s_pStainFrameOffsets[STAIN_FRAME_PRESET_COUNT]) {
-			s_pNextStainOffset = &s_pStainFrameOffsets[0];
-		}
-	}
+	bobsSaveDrawnHeights();
 
+	blitHogPhaseBegin(BLIT_HOG_PHASE_HUD);
 	s_ubBufferCurr = !s_ubBufferCurr;
 
 	hudProcess();
+	blitHogPhaseEnd();
+	sfxQueueFlush();
 
+#if defined(GAME_BG_RING_BUFFER)
+	gameBufferProcess(g_pGameBufferMain);
+#else
 	simpleBufferProcess(g_pGameBufferMain);
+#endif
 	cameraProcess(g_pGameBufferMain->pCamera);
+	blitQueueFrameEnd();
 	copSwapBuffers();
 	gameWaitForNextFrame();
+#if defined(MIXER_COUNTER)
+	gameMixerProfileFrame();
+#endif
 }
 
 static void gameGsDestroy(void) {
+#if defined(GAME_DEBUG)
+	logWrite(
+		"Bobs culled: %lu total, max %hu per frame\n",
+		s_ulBobsCulledTotal, s_uwBobsCulledMax
+	);
+#if !defined(ACE_BOB_PRISTINE_BUFFER)
+	logWrite(
+		"Bg decal tiles used: %hhu/%d, recycled: %lu\n",
+		s_ubBgDecalCount, BG_DECAL_TILES_MAX, s_ulBgDecalsRecycled
+	);
+#endif
+	logWrite("Stains pending: max %hhu\n", s_ubStainsPendingMax);
+	logWrite(
+		"Undraw: avg %lu lines per frame, playfield memory: %lu bytes CHIP\n",
+		blitHogGetAverage(BLIT_HOG_PHASE_UNDRAW), s_ulPlayfieldChipBytes
+	);
+#endif
+#if defined(MIXER_COUNTER)
+	gameMixerProfileLog();
+#endif
+	blitQueueDestroy();
 	viewLoad(0);
 	ptplayerStop();
 	systemUse();
 
 	commDestroy();
 
+	spriteMuxDestroy();
 	spriteManagerDestroy();
 	bitmapDestroy(s_pBmCursorFrames);
 	bitmapDestroy(s_pBmCursor);
@@ -2565,6 +3871,9 @@ static void gameGsDestroy(void) {
 	bitmapDestroy(s_pPlayerBlinkBitmaps[0]);
 	bitmapDestroy(s_pPlayerBlinkBitmaps[1]);
 
+	for(UBYTE i = 0; i < PICKUP_KIND_COUNT; ++i) {
+		spriteMuxFrameDestroy(&s_pPickupSpriteFrames[i]);
+	}
 	bitmapDestroy(s_pPickupFrames);
 	bitmapDestroy(s_pPickupMasks);
 	bitmapDestroy(s_pBulletFrames);
@@ -2575,10 +3884,16 @@ static void gameGsDestroy(void) {
 	bitmapDestroy(s_pStainMasks);
 
 	viewDestroy(s_pView);
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 	bitmapDestroy(g_pGamePristineBuffer);
+#else
+	bitmapDestroy(s_pBgDecals);
+#endif
 	bitmapDestroy(s_pHudWeapons);
 	bitmapDestroy(s_pHudLevelUp);
+	bitmapDestroy(s_pBmHudDigits);
 	bitmapDestroy(s_pTileset);
+	sfxSequenceDestroy();
 	assetsGameDestroy();
 }
 
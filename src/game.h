@@ -7,27 +7,47 @@
 
 #include <ace/managers/state.h>
 #include <ace/managers/viewport/simplebuffer.h>
-#include <ace/managers/rand.h>
 #include <ace/utils/font.h>
 #include "perks.h"
+#include "game_layout.h"
 
 // #define GAME_COLLISION_DEBUG
-#define GAME_BPP 5
 #define GAME_HUD_BPP 4
 #define GAME_HUD_PALETTE_COLORS 13
-#define GAME_HUD_VPORT_SIZE_Y 16
-#define GAME_MAIN_VPORT_SIZE_X 320
-#define GAME_MAIN_VPORT_SIZE_Y (256 - GAME_HUD_VPORT_SIZE_Y)
 #define GAME_FPS 25
 
 #define CURSOR_SIZE 9
 #define GAME_CURSOR_OFFSET_X (CURSOR_SIZE / 2)
 #define GAME_CURSOR_OFFSET_Y (CURSOR_SIZE / 2)
 
+#if defined(GAME_BG_RING_BUFFER)
+/**
+ * @brief Main playfield buffer manager. Buffers are map-wide, but hold only
+ * BG_RING_SIZE_Y rows, on which map rows wrap. Copper re-points bitplanes
+ * to the first row where wrap gets into view.
+ */
+typedef struct tGameRingBuffer {
+	tVpManager sCommon;
+	tCameraManager *pCamera;
+	tBitMap *pFront;
+	tBitMap *pBack;
+	UWORD uwCopperOffset;
+	UBYTE ubFrontTileTop; ///< First bg tile row held by front buffer.
+	UBYTE ubFrontTileBottom; ///< Last bg tile row held by front buffer.
+	UBYTE ubBackTileTop;
+	UBYTE ubBackTileBottom;
+} tGameRingBuffer;
+#endif
+
 extern tState g_sStateGame;
+#if defined(GAME_BG_RING_BUFFER)
+extern tGameRingBuffer *g_pGameBufferMain;
+#else
 extern tSimpleBufferManager *g_pGameBufferMain;
+#endif
+#if defined(ACE_BOB_PRISTINE_BUFFER)
 extern tBitMap *g_pGamePristineBuffer;
-extern tRandManager g_sRand;
+#endif
 
 void gameStart(void);
 
@@ -43,6 +63,24 @@ void gameResume(void);
 
 void gameDiscardUndraw(void);
 
+#if defined(GAME_BG_RING_BUFFER)
+/**
+ * @brief Moves view to top rows of both main buffers & sets camera Y to 0,
+ * so that overlays may draw on it using camera coords without wrapping.
+ * Map camera position is brought back by gameResume() or gameStart().
+ */
+void gameBufferUnwrap(void);
+#endif
+
+/**
+ * @brief Copies clean map background, i.e. tiles with stains but without
+ * any bobs, from given map area to given bitmap.
+ */
+void gameRestoreBackground(
+	tBitMap *pDst, UWORD uwDstX, UWORD uwDstY,
+	UWORD uwX, UWORD uwY, UWORD uwWidth, UWORD uwHeight
+);
+
 void gameProcessCursor(UWORD uwMouseX, UWORD uwMouseY);
 
 void gameApplyPerk(tPerk ePerk);
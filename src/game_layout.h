@@ -0,0 +1,46 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_GAME_LAYOUT_H
+#define SURVIVOR_GAME_LAYOUT_H
+
+// Screen & map dimensions. Kept free of any includes, since they're also
+// used by host-side lookup table generator.
+
+#define GAME_BPP 5
+#define GAME_HUD_VPORT_SIZE_Y 16
+#define GAME_MAIN_VPORT_SIZE_X 320
+#define GAME_MAIN_VPORT_SIZE_Y (256 - GAME_HUD_VPORT_SIZE_Y)
+
+#define MAP_TILES_X 32
+// Set by GAME_MAP_TILES_Y build option. With GAME_BG_RING_BUFFER main buffers
+// don't grow with it, otherwise they hold whole map height.
+#if defined(GAME_MAP_TILES_Y)
+#define MAP_TILES_Y GAME_MAP_TILES_Y
+#else
+#define MAP_TILES_Y 32
+#endif
+#define MAP_MARGIN_TILES 2
+#define MAP_TILE_SHIFT 4
+#define MAP_TILE_SIZE (1 << MAP_TILE_SHIFT)
+
+#define BG_BYTES_PER_BITPLANE_ROW (MAP_TILES_X * MAP_TILE_SIZE / 8)
+#define BG_BYTES_PER_PIXEL_ROW (BG_BYTES_PER_BITPLANE_ROW * GAME_BPP)
+
+#if defined(GAME_BG_RING_BUFFER)
+// Rows held by main buffers, map rows wrap on them. Must fit view with
+// refill margins & be a multiple of bg tile size, so that tiles don't wrap.
+#define BG_RING_SIZE_Y 384
+#endif
+
+#define COLLISION_SIZE_X 8
+#define COLLISION_SIZE_Y 8
+#define COLLISION_LOOKUP_SIZE_X (MAP_TILES_X * MAP_TILE_SIZE / COLLISION_SIZE_X)
+#define COLLISION_LOOKUP_SIZE_Y (MAP_TILES_Y * MAP_TILE_SIZE / COLLISION_SIZE_Y)
+#define RESPAWN_SLOTS_PER_POSITION 4
+
+#define ENEMY_BOB_SIZE_X 16
+#define ENEMY_BOB_SIZE_Y 24
+
+#endif // SURVIVOR_GAME_LAYOUT_H
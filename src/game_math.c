@@ -3,11 +3,17 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "game_math.h"
-#include <ace/generic/screen.h>
-#include <ace/managers/system.h>
-#include <ace/utils/disk_file.h>
+#if defined(GAME_MATH_BENCHMARK)
+#include <ace/managers/log.h>
+#include <ace/managers/memory.h>
+#include <ace/managers/timer.h>
 
-static WORD s_pAtan2[SCREEN_PAL_HEIGHT / GAME_MATH_ATAN2_SCALE][SCREEN_PAL_WIDTH / GAME_MATH_ATAN2_SCALE];
+#define BENCHMARK_ATAN2_SCALE 4
+#define BENCHMARK_ATAN2_SIZE_X (320 / BENCHMARK_ATAN2_SCALE)
+#define BENCHMARK_ATAN2_SIZE_Y (256 / BENCHMARK_ATAN2_SCALE)
+#define BENCHMARK_STEP 3
+#define BENCHMARK_RUNS 8
+#endif
 
 UBYTE getAngleBetweenPoints(
 	UWORD uwSrcX, UWORD uwSrcY, UWORD uwDstX, UWORD uwDstY
@@ -30,12 +36,34 @@ WORD getDeltaAngleDirection(UBYTE ubPrevAngle, UBYTE ubNewAngle, WORD wUnit) {
 	return -wUnit;
 }
 
+static inline UBYTE catan2Octant(UWORD uwMin, UWORD uwMax) {
+	UWORD uwRatio = (
+		((ULONG)uwMin << GAME_MATH_ATAN_RATIO_SHIFT) + (uwMax >> 1)
+	) / uwMax;
+	return g_pAtanOctant[uwRatio];
+}
+
 WORD catan2(WORD wDy, WORD wDx) {
-	return
-		wDx >= 0 && wDy >= 0 ? s_pAtan2[wDy / GAME_MATH_ATAN2_SCALE][wDx / GAME_MATH_ATAN2_SCALE] :
-		wDx >= 0 && wDy < 0 ? (ANGLE_360 - s_pAtan2[((UWORD)-wDy) / GAME_MATH_ATAN2_SCALE][wDx / GAME_MATH_ATAN2_SCALE]) :
-		wDx < 0 && wDy >= 0 ? (ANGLE_180 - s_pAtan2[wDy / GAME_MATH_ATAN2_SCALE][((UWORD)-wDx) / GAME_MATH_ATAN2_SCALE]) :
-		/* wDx < 0 && wDy < 0 ? */ (ANGLE_180 + s_pAtan2[((UWORD)-wDy) / GAME_MATH_ATAN2_SCALE][((UWORD)-wDx) / GAME_MATH_ATAN2_SCALE]);
+	UWORD uwAbsX = (wDx >= 0) ? wDx : (UWORD)-wDx;
+	UWORD uwAbsY = (wDy >= 0) ? wDy : (UWORD)-wDy;
+	WORD wAngle;
+	if(uwAbsX >= uwAbsY) {
+		if(!uwAbsX) {
+			return ANGLE_0;
+		}
+		wAngle = catan2Octant(uwAbsY, uwAbsX);
+	}
+	else {
+		wAngle = ANGLE_90 - catan2Octant(uwAbsX, uwAbsY);
+	}
+
+	if(wDx < 0) {
+		wAngle = ANGLE_180 - wAngle;
+	}
+	if(wDy < 0) {
+		wAngle = ANGLE_360 - wAngle;
+	}
+	return wAngle;
 }
 
 UWORD fastMagnitude(UWORD uwDx, UWORD uwDy) {
@@ -58,38 +86,93 @@ UWORD fastMagnitude(UWORD uwDx, UWORD uwDy) {
 	return uwPPlusHalfQ - (uwPPlusHalfQ >> 4);
 }
 
-void gameMathInit(void) {
-#if defined(GAME_MATH_PRECALCULATED)
-	systemUse();
-	tFile *pFile = diskFileOpen("data/game_math.dat", DISK_FILE_MODE_READ, 1);
-	fileRead(pFile, s_pAtan2, sizeof(s_pAtan2));
-	fileRead(pFile, g_pSin, sizeof(g_pSin));
-	fileClose(pFile);
-	systemUnuse();
-#else
-	for(UWORD uwY = 0; uwY < SCREEN_PAL_HEIGHT / GAME_MATH_ATAN2_SCALE; ++uwY) {
-		for(UWORD uwX = 0; uwX < SCREEN_PAL_WIDTH / GAME_MATH_ATAN2_SCALE; ++uwX) {
-			s_pAtan2[uwY][uwX] = fix16_to_int(fix16_one/2 + fix16_div(ANGLE_180 * fix16_atan2(fix16_from_int(uwY), fix16_from_int(uwX)), fix16_pi));
-			if(s_pAtan2[uwY][uwX] >= ANGLE_360) {
-				s_pAtan2[uwY][uwX] -= ANGLE_360;
-			}
+#if defined(GAME_MATH_BENCHMARK)
+
+// Former atan2 lookup, indexed by scaled-down delta components.
+static WORD benchmarkAtan2Old(
+	WORD pAtan2[BENCHMARK_ATAN2_SIZE_Y][BENCHMARK_ATAN2_SIZE_X],
+	WORD wDy, WORD wDx
+) {
+	return
+		wDx >= 0 && wDy >= 0 ? pAtan2[wDy / BENCHMARK_ATAN2_SCALE][wDx / BENCHMARK_ATAN2_SCALE] :
+		wDx >= 0 && wDy < 0 ? (ANGLE_360 - pAtan2[((UWORD)-wDy) / BENCHMARK_ATAN2_SCALE][wDx / BENCHMARK_ATAN2_SCALE]) :
+		wDx < 0 && wDy >= 0 ? (ANGLE_180 - pAtan2[wDy / BENCHMARK_ATAN2_SCALE][((UWORD)-wDx) / BENCHMARK_ATAN2_SCALE]) :
+		/* wDx < 0 && wDy < 0 ? */ (ANGLE_180 + pAtan2[((UWORD)-wDy) / BENCHMARK_ATAN2_SCALE][((UWORD)-wDx) / BENCHMARK_ATAN2_SCALE]);
+}
+
+static fix16_t benchmarkAngleError(WORD wAngle, WORD wDy, WORD wDx) {
+	fix16_t fExact = fix16_div(
+		ANGLE_180 * fix16_atan2(fix16_from_int(wDy), fix16_from_int(wDx)),
+		fix16_pi
+	);
+	fix16_t fError = fix16_abs(fix16_from_int(wAngle) - fExact);
+	fError %= fix16_from_int(ANGLE_360);
+	return MIN(fError, fix16_from_int(ANGLE_360) - fError);
+}
+
+void gameMathBenchmark(void) {
+	logBlockBegin("gameMathBenchmark()");
+	typedef WORD tAtan2Row[BENCHMARK_ATAN2_SIZE_X];
+	tAtan2Row *pAtan2 = memAllocFast(
+		sizeof(tAtan2Row) * BENCHMARK_ATAN2_SIZE_Y
+	);
+	for(UWORD uwY = 0; uwY < BENCHMARK_ATAN2_SIZE_Y; ++uwY) {
+		for(UWORD uwX = 0; uwX < BENCHMARK_ATAN2_SIZE_X; ++uwX) {
+			pAtan2[uwY][uwX] = gameTablesCalcAtan2(uwY, uwX);
 		}
 	}
-	s_pAtan2[0][0] = ANGLE_0;
 
-	for(UWORD uwAngle = 0; uwAngle < GAME_MATH_ANGLE_COUNT; ++uwAngle) {
-		g_pSin[uwAngle] = fix16_sin((uwAngle * 2 * fix16_pi) / GAME_MATH_ANGLE_COUNT);
+	// Accuracy against fix16_atan2 over whole screen range of deltas
+	fix16_t fMaxErrOld = 0, fMaxErrNew = 0;
+	ULONG ulSumErrOld = 0, ulSumErrNew = 0, ulSamples = 0;
+	for(WORD wDy = -255; wDy < 256; wDy += BENCHMARK_STEP) {
+		for(WORD wDx = -319; wDx < 320; wDx += BENCHMARK_STEP) {
+			fix16_t fErrOld = benchmarkAngleError(benchmarkAtan2Old(pAtan2, wDy, wDx), wDy, wDx);
+			fix16_t fErrNew = benchmarkAngleError(catan2(wDy, wDx), wDy, wDx);
+			fMaxErrOld = MAX(fMaxErrOld, fErrOld);
+			fMaxErrNew = MAX(fMaxErrNew, fErrNew);
+			ulSumErrOld += fErrOld >> 8;
+			ulSumErrNew += fErrNew >> 8;
+			++ulSamples;
+		}
 	}
+	logWrite(
+		"Atan2 error in 1/256 angle units, old: max %ld avg %lu, new: max %ld avg %lu\n",
+		(LONG)(fMaxErrOld >> 8), ulSumErrOld / ulSamples,
+		(LONG)(fMaxErrNew >> 8), ulSumErrNew / ulSamples
+	);
 
-#if defined(GAME_MATH_SAVE_PRECALC)
-	systemUse();
-	tFile *pFile = diskFileOpen("data/game_math.dat", DISK_FILE_MODE_WRITE, 1);
-	fileWrite(pFile, s_pAtan2, sizeof(s_pAtan2));
-	fileWrite(pFile, g_pSin, sizeof(g_pSin));
-	fileClose(pFile);
-	systemUnuse();
-#endif
-#endif
+	// Speed, with the same deltas for both
+	char szTimeOld[15], szTimeNew[15];
+	volatile WORD wSink;
+	ULONG ulStart = timerGetPrec();
+	for(UBYTE ubRun = 0; ubRun < BENCHMARK_RUNS; ++ubRun) {
+		for(WORD wDy = -255; wDy < 256; wDy += BENCHMARK_STEP) {
+			for(WORD wDx = -319; wDx < 320; wDx += BENCHMARK_STEP) {
+				wSink = benchmarkAtan2Old(pAtan2, wDy, wDx);
+			}
+		}
+	}
+	timerFormatPrec(szTimeOld, timerGetDelta(ulStart, timerGetPrec()));
+	ulStart = timerGetPrec();
+	for(UBYTE ubRun = 0; ubRun < BENCHMARK_RUNS; ++ubRun) {
+		for(WORD wDy = -255; wDy < 256; wDy += BENCHMARK_STEP) {
+			for(WORD wDx = -319; wDx < 320; wDx += BENCHMARK_STEP) {
+				wSink = catan2(wDy, wDx);
+			}
+		}
+	}
+	timerFormatPrec(szTimeNew, timerGetDelta(ulStart, timerGetPrec()));
+	(void)wSink;
+	logWrite(
+		"Atan2 %lu calls, old: %s, new: %s; table size old: %lu, new: %lu\n",
+		ulSamples * BENCHMARK_RUNS, szTimeOld, szTimeNew,
+		(ULONG)(sizeof(tAtan2Row) * BENCHMARK_ATAN2_SIZE_Y),
+		(ULONG)sizeof(g_pAtanOctant)
+	);
+
+	memFree(pAtan2, sizeof(tAtan2Row) * BENCHMARK_ATAN2_SIZE_Y);
+	logBlockEnd("gameMathBenchmark()");
 }
 
-fix16_t g_pSin[GAME_MATH_ANGLE_COUNT];
+#endif // defined(GAME_MATH_BENCHMARK)
@@ -5,30 +5,15 @@
 #ifndef SURVIVOR_GAME_MATH_H
 #define SURVIVOR_GAME_MATH_H
 
-#include <ace/types.h>
-#include <fixmath/fix16.h>
+#include "game_tables.h"
 
-#define GAME_MATH_ANGLE_COUNT 128
-#define GAME_MATH_ATAN2_SCALE 4
-#define GAME_MATH_PRECALCULATED
-// #define GAME_MATH_SAVE_PRECALC
-
-#define ANGLE_360  (GAME_MATH_ANGLE_COUNT)
-#define ANGLE_180  (ANGLE_360 / 2)
-#define ANGLE_90   (ANGLE_360 / 4)
-#define ANGLE_60   (ANGLE_360 / 6)
-#define ANGLE_45   (ANGLE_360 / 8)
-#define ANGLE_30   (ANGLE_360 / 12)
-#define ANGLE_15   (ANGLE_360 / 24)
-#define ANGLE_0    0
-#define ANGLE_LAST ((GAME_MATH_ANGLE_COUNT)-1)
+// Logs accuracy & speed of catan2() against former per-delta table at start.
+// #define GAME_MATH_BENCHMARK
 
 #define csin(x) (g_pSin[x])
 #define ccos(x) (((x) < 3 * ANGLE_90) ? csin(ANGLE_90 + (x)) : csin((x) - (3 * ANGLE_90)))
 #define angleToFrame(angle) (angle>>1)
 
-extern fix16_t g_pSin[GAME_MATH_ANGLE_COUNT];
-
 /**
  *  Calculates angle between source and destination points.
  *  Source point is center of circle, destination is orbiting around it.
@@ -55,9 +40,20 @@ WORD getDeltaAngleDirection(
 	UBYTE ubPrevAngle, UBYTE ubNewAngle, WORD wUnit
 );
 
+/**
+ *  Calculates angle of given vector, 0 pointing right, going clockwise.
+ *  Looks up first octant's atan by ratio of smaller & larger component,
+ *  then unfolds it by component signs & order.
+ *  @param wDy Vector Y.
+ *  @param wDx Ditto, X.
+ *  @return Angle value between ANGLE_0 and ANGLE_360 - ANGLE_360 must be
+ *  wrapped by caller.
+ */
 WORD catan2(WORD wDy, WORD wDx);
 
-void gameMathInit(void);
+#if defined(GAME_MATH_BENCHMARK)
+void gameMathBenchmark(void);
+#endif
 
 UWORD fastMagnitude(UWORD uwDx, UWORD uwDy);
 
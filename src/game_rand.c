@@ -0,0 +1,15 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "game_rand.h"
+#include <ace/managers/log.h>
+
+ULONG g_pGameRandStates[GAME_RAND_STREAM_COUNT];
+
+void gameRandSeed(ULONG ulSeed) {
+	logWrite("Game rand seed: 0x%08lX\n", ulSeed);
+	for(tGameRandStream eStream = 0; eStream < GAME_RAND_STREAM_COUNT; ++eStream) {
+		g_pGameRandStates[eStream] = gameRandGetStreamState(ulSeed, eStream);
+	}
+}
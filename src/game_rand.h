@@ -0,0 +1,108 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_GAME_RAND_H
+#define SURVIVOR_GAME_RAND_H
+
+// With GAME_TABLES_HOST defined, includer must provide ACE integer types
+// itself - tools/table_gen uses it to bake tables drawn from default seed.
+#if !defined(GAME_TABLES_HOST)
+#include <ace/types.h>
+#endif
+
+#define GAME_RAND_DEFAULT_SEED 0x08880777
+// Initial outputs of xorshift are poorly mixed for similar states.
+#define GAME_RAND_WARMUP_ROUNDS 8
+
+/**
+ * @brief Independent random sequences, so that e.g. spawning more enemies
+ * won't change the next generated map.
+ */
+typedef enum tGameRandStream {
+	GAME_RAND_STREAM_MAP,
+	GAME_RAND_STREAM_SPREAD, ///< Only drawn by weapon spread table calc.
+	GAME_RAND_STREAM_STAINS,
+	GAME_RAND_STREAM_ENEMIES,
+	GAME_RAND_STREAM_PICKUPS,
+	GAME_RAND_STREAM_PERKS,
+	GAME_RAND_STREAM_COUNT
+} tGameRandStream;
+
+extern ULONG g_pGameRandStates[GAME_RAND_STREAM_COUNT];
+
+/**
+ * @brief Derives states of all streams from given seed & logs it, so that
+ * the run can be reproduced.
+ */
+void gameRandSeed(ULONG ulSeed);
+
+/**
+ * @brief Calculates next xorshift32 state.
+ * Uses only integer shifts & xors, so sequence is same on every compiler.
+ */
+__attribute__((always_inline))
+static inline ULONG gameRandNext(ULONG ulState) {
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+
+/**
+ * @brief Calculates given stream's initial state from seed.
+ */
+static inline ULONG gameRandGetStreamState(ULONG ulSeed, tGameRandStream eStream) {
+	// Golden ratio increment spreads stream states apart
+	ULONG ulState = ulSeed ^ (0x9E3779B9 * (eStream + 1));
+	if(!ulState) {
+		// xorshift would be stuck at zero
+		ulState = 0x9E3779B9;
+	}
+	for(UBYTE i = 0; i < GAME_RAND_WARMUP_ROUNDS; ++i) {
+		ulState = gameRandNext(ulState);
+	}
+	return ulState;
+}
+
+/**
+ * @brief Scales random value to range between 0 and uwMax, inclusive.
+ * Uses multiplication instead of modulo, so no division is done.
+ * @param uwMax Must be less than 0xFFFF.
+ */
+__attribute__((always_inline))
+static inline UWORD gameRandScale(UWORD uwRand, UWORD uwMax) {
+	return ((ULONG)uwRand * (UWORD)(uwMax + 1)) >> 16;
+}
+
+/**
+ * @brief Advances given stream's xorshift32 state.
+ * @return Upper half of the new state.
+ */
+__attribute__((always_inline))
+static inline UWORD gameRandUw(tGameRandStream eStream) {
+	ULONG ulState = gameRandNext(g_pGameRandStates[eStream]);
+	g_pGameRandStates[eStream] = ulState;
+	return ulState >> 16;
+}
+
+/**
+ * @brief Returns random value between 0 and uwMax, inclusive.
+ * @param uwMax Must be less than 0xFFFF.
+ */
+__attribute__((always_inline))
+static inline UWORD gameRandUwMax(tGameRandStream eStream, UWORD uwMax) {
+	return gameRandScale(gameRandUw(eStream), uwMax);
+}
+
+/**
+ * @brief Returns random value between uwMin and uwMax, inclusive.
+ */
+__attribute__((always_inline))
+static inline UWORD gameRandUwMinMax(
+	tGameRandStream eStream, UWORD uwMin, UWORD uwMax
+) {
+	return uwMin + gameRandUwMax(eStream, uwMax - uwMin);
+}
+
+#endif // SURVIVOR_GAME_RAND_H
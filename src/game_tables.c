@@ -0,0 +1,56 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "game_tables.h"
+
+#if !defined(GAME_TABLES_MATH_GENERATED)
+UBYTE g_pAtanOctant[GAME_MATH_ATAN_RATIO_COUNT + 1];
+fix16_t g_pSin[GAME_MATH_ANGLE_COUNT];
+tFix10p6 g_pSin10p6[GAME_MATH_ANGLE_COUNT];
+#endif
+
+#if !defined(GAME_TABLES_DATA_GENERATED)
+ULONG g_pRowOffsetFromY[GAME_TABLES_ROW_COUNT];
+UWORD g_pRespawnSlotX[COLLISION_LOOKUP_SIZE_X][RESPAWN_SLOTS_PER_POSITION];
+UWORD g_pRespawnSlotY[COLLISION_LOOKUP_SIZE_Y][RESPAWN_SLOTS_PER_POSITION];
+BYTE g_pSpreadSide1[SPREAD_SIDE_COUNT];
+BYTE g_pSpreadSide2[SPREAD_SIDE_COUNT];
+BYTE g_pSpreadSide3[SPREAD_SIDE_COUNT];
+BYTE g_pSpreadSide10[SPREAD_SIDE_COUNT];
+#endif
+
+void gameTablesInit(void) {
+	// Generated tables are already in the binary
+#if !defined(GAME_TABLES_MATH_GENERATED)
+	for(UWORD uwRatio = 0; uwRatio <= GAME_MATH_ATAN_RATIO_COUNT; ++uwRatio) {
+		g_pAtanOctant[uwRatio] = gameTablesCalcAtanOctant(uwRatio);
+	}
+
+	for(UWORD uwAngle = 0; uwAngle < GAME_MATH_ANGLE_COUNT; ++uwAngle) {
+		g_pSin[uwAngle] = gameTablesCalcSin(uwAngle);
+		g_pSin10p6[uwAngle] = gameTablesCalcSin10p6(uwAngle);
+	}
+#endif
+
+#if !defined(GAME_TABLES_DATA_GENERATED)
+	for(UWORD uwY = 0; uwY < GAME_TABLES_ROW_COUNT; ++uwY) {
+		g_pRowOffsetFromY[uwY] = gameTablesCalcRowOffset(uwY);
+	}
+
+	for(UWORD uwX = 0; uwX < COLLISION_LOOKUP_SIZE_X; ++uwX) {
+		for(UBYTE ubSlot = 0; ubSlot < RESPAWN_SLOTS_PER_POSITION; ++ubSlot) {
+			g_pRespawnSlotX[uwX][ubSlot] = gameTablesCalcRespawnSlotX(uwX, ubSlot);
+		}
+	}
+	for(UWORD uwY = 0; uwY < COLLISION_LOOKUP_SIZE_Y; ++uwY) {
+		for(UBYTE ubSlot = 0; ubSlot < RESPAWN_SLOTS_PER_POSITION; ++ubSlot) {
+			g_pRespawnSlotY[uwY][ubSlot] = gameTablesCalcRespawnSlotY(uwY, ubSlot);
+		}
+	}
+
+	gameTablesCalcSpreadSides(
+		g_pSpreadSide1, g_pSpreadSide2, g_pSpreadSide3, g_pSpreadSide10
+	);
+#endif
+}
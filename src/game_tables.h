@@ -0,0 +1,40 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_GAME_TABLES_H
+#define SURVIVOR_GAME_TABLES_H
+
+#include "game_tables_calc.h"
+
+// With GAME_TABLES_DATA_GENERATED / GAME_TABLES_MATH_GENERATED, tables are
+// emitted at build time by tools/table_gen as const arrays, otherwise they're
+// filled at startup. Math ones need libfixmath on the host, data ones don't.
+#if defined(GAME_TABLES_DATA_GENERATED)
+#define GAME_TABLE_DATA const
+#else
+#define GAME_TABLE_DATA
+#endif
+#if defined(GAME_TABLES_MATH_GENERATED)
+#define GAME_TABLE_MATH const
+#else
+#define GAME_TABLE_MATH
+#endif
+
+extern GAME_TABLE_MATH UBYTE g_pAtanOctant[GAME_MATH_ATAN_RATIO_COUNT + 1];
+extern GAME_TABLE_MATH fix16_t g_pSin[GAME_MATH_ANGLE_COUNT];
+extern GAME_TABLE_MATH tFix10p6 g_pSin10p6[GAME_MATH_ANGLE_COUNT];
+extern GAME_TABLE_DATA ULONG g_pRowOffsetFromY[GAME_TABLES_ROW_COUNT];
+extern GAME_TABLE_DATA UWORD g_pRespawnSlotX[COLLISION_LOOKUP_SIZE_X][RESPAWN_SLOTS_PER_POSITION];
+extern GAME_TABLE_DATA UWORD g_pRespawnSlotY[COLLISION_LOOKUP_SIZE_Y][RESPAWN_SLOTS_PER_POSITION];
+extern GAME_TABLE_DATA BYTE g_pSpreadSide1[SPREAD_SIDE_COUNT];
+extern GAME_TABLE_DATA BYTE g_pSpreadSide2[SPREAD_SIDE_COUNT];
+extern GAME_TABLE_DATA BYTE g_pSpreadSide3[SPREAD_SIDE_COUNT];
+extern GAME_TABLE_DATA BYTE g_pSpreadSide10[SPREAD_SIDE_COUNT];
+
+/**
+ * @brief Fills lookup tables unless they were generated at build time.
+ */
+void gameTablesInit(void);
+
+#endif // SURVIVOR_GAME_TABLES_H
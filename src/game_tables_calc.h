@@ -0,0 +1,152 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_GAME_TABLES_CALC_H
+#define SURVIVOR_GAME_TABLES_CALC_H
+
+// Lookup table entry formulas, shared by the game's runtime fallback and
+// host-side generator in tools/table_gen, so that both give same results.
+// With GAME_TABLES_HOST defined, includer must provide ACE integer types
+// and CLAMP() itself, and math table formulas are only there along with
+// GAME_TABLES_HOST_MATH, since they need libfixmath.
+
+#if !defined(GAME_TABLES_HOST)
+#include <ace/types.h>
+#include <ace/macros.h>
+#endif
+#if !defined(GAME_TABLES_HOST) || defined(GAME_TABLES_HOST_MATH)
+#include <fixmath/fix16.h>
+#endif
+#include "game_layout.h"
+#include "game_rand.h"
+
+#define GAME_MATH_ANGLE_COUNT 128
+// Atan is looked up by min/max ratio of delta components, scaled by this
+#define GAME_MATH_ATAN_RATIO_SHIFT 6
+#define GAME_MATH_ATAN_RATIO_COUNT (1 << GAME_MATH_ATAN_RATIO_SHIFT)
+
+#define ANGLE_360  (GAME_MATH_ANGLE_COUNT)
+#define ANGLE_180  (ANGLE_360 / 2)
+#define ANGLE_90   (ANGLE_360 / 4)
+#define ANGLE_60   (ANGLE_360 / 6)
+#define ANGLE_45   (ANGLE_360 / 8)
+#define ANGLE_30   (ANGLE_360 / 12)
+#define ANGLE_15   (ANGLE_360 / 24)
+#define ANGLE_0    0
+#define ANGLE_LAST ((GAME_MATH_ANGLE_COUNT)-1)
+
+#define GAME_TABLES_ROW_COUNT (MAP_TILES_Y * MAP_TILE_SIZE)
+#define SPREAD_SIDE_COUNT 40
+
+// Signed, for sine & projectile deltas
+typedef WORD tFix10p6;
+
+#if !defined(GAME_TABLES_HOST) || defined(GAME_TABLES_HOST_MATH)
+
+/**
+ * @brief Formula of former per-delta atan2 table, which rounded angles up.
+ * Kept as a baseline for GAME_MATH_BENCHMARK.
+ */
+static inline WORD gameTablesCalcAtan2(UWORD uwY, UWORD uwX) {
+	if(!uwY && !uwX) {
+		return ANGLE_0;
+	}
+	WORD wAngle = fix16_to_int(fix16_one/2 + fix16_div(ANGLE_180 * fix16_atan2(fix16_from_int(uwY), fix16_from_int(uwX)), fix16_pi));
+	if(wAngle >= ANGLE_360) {
+		wAngle -= ANGLE_360;
+	}
+	return wAngle;
+}
+
+/**
+ * @brief Calculates angle of given ratio in first octant, i.e. atan of
+ * uwRatio / GAME_MATH_ATAN_RATIO_COUNT, between ANGLE_0 and ANGLE_45.
+ */
+static inline UBYTE gameTablesCalcAtanOctant(UWORD uwRatio) {
+	return fix16_to_int(fix16_div(ANGLE_180 * fix16_atan2(fix16_from_int(uwRatio), fix16_from_int(GAME_MATH_ATAN_RATIO_COUNT)), fix16_pi));
+}
+
+static inline fix16_t gameTablesCalcSin(UWORD uwAngle) {
+	return fix16_sin((uwAngle * 2 * fix16_pi) / GAME_MATH_ANGLE_COUNT);
+}
+
+static inline tFix10p6 gameTablesCalcSin10p6(UWORD uwAngle) {
+	return gameTablesCalcSin(uwAngle) >> 10;
+}
+
+#endif // !defined(GAME_TABLES_HOST) || defined(GAME_TABLES_HOST_MATH)
+
+static inline ULONG gameTablesCalcRowOffset(UWORD uwY) {
+#if defined(GAME_BG_RING_BUFFER)
+	uwY %= BG_RING_SIZE_Y;
+#endif
+	return uwY * BG_BYTES_PER_PIXEL_ROW;
+}
+
+/**
+ * @brief Calculates X of enemy respawn position just outside of the camera
+ * centered on given collision tile column. Slot's X doesn't depend on tile's
+ * row & vice versa, so each axis has its own table, not growing with map area.
+ * @param ubSlot 0: left, 1: right, 2: up, 3: down.
+ */
+static inline UWORD gameTablesCalcRespawnSlotX(UWORD uwLookupX, UBYTE ubSlot) {
+	ULONG ulCenterX = uwLookupX * COLLISION_SIZE_X;
+	LONG lLeft = ulCenterX - GAME_MAIN_VPORT_SIZE_X / 2;
+	lLeft = CLAMP(lLeft, MAP_MARGIN_TILES * MAP_TILE_SIZE, (MAP_TILES_X - MAP_MARGIN_TILES) * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_X);
+
+	switch(ubSlot) {
+		case 0:
+			return CLAMP(lLeft - ENEMY_BOB_SIZE_X, ENEMY_BOB_SIZE_X, MAP_TILES_X * MAP_TILE_SIZE - ENEMY_BOB_SIZE_X);
+		case 1:
+			return CLAMP(lLeft + GAME_MAIN_VPORT_SIZE_X + ENEMY_BOB_SIZE_X, ENEMY_BOB_SIZE_X, MAP_TILES_X * MAP_TILE_SIZE - ENEMY_BOB_SIZE_X);
+		default:
+			return ulCenterX;
+	}
+}
+
+/**
+ * @brief Calculates Y of enemy respawn position, counterpart of
+ * gameTablesCalcRespawnSlotX() for collision tile rows.
+ */
+static inline UWORD gameTablesCalcRespawnSlotY(UWORD uwLookupY, UBYTE ubSlot) {
+	ULONG ulCenterY = uwLookupY * COLLISION_SIZE_Y;
+	LONG lTop = ulCenterY - (GAME_MAIN_VPORT_SIZE_Y - GAME_HUD_VPORT_SIZE_Y) / 2;
+	lTop = CLAMP(lTop, MAP_MARGIN_TILES * MAP_TILE_SIZE, (MAP_TILES_Y - MAP_MARGIN_TILES) * MAP_TILE_SIZE - GAME_MAIN_VPORT_SIZE_Y);
+
+	switch(ubSlot) {
+		case 2:
+			return CLAMP(lTop - ENEMY_BOB_SIZE_Y, ENEMY_BOB_SIZE_Y, MAP_TILES_Y * MAP_TILE_SIZE - ENEMY_BOB_SIZE_Y);
+		case 3:
+			return CLAMP(lTop + GAME_MAIN_VPORT_SIZE_Y + ENEMY_BOB_SIZE_Y, ENEMY_BOB_SIZE_Y, MAP_TILES_Y * MAP_TILE_SIZE - ENEMY_BOB_SIZE_Y);
+		default:
+			return ulCenterY;
+	}
+}
+
+/**
+ * @brief Fills weapon spread tables with side offsets between -N/2 and N/2,
+ * N being 2, 4, 6 & 20. Entries are drawn in sequence from spread stream of
+ * GAME_RAND_DEFAULT_SEED, which nothing else uses, so tables are the same
+ * whenever they're calculated.
+ */
+static inline void gameTablesCalcSpreadSides(
+	BYTE pSide1[static SPREAD_SIDE_COUNT], BYTE pSide2[static SPREAD_SIDE_COUNT],
+	BYTE pSide3[static SPREAD_SIDE_COUNT], BYTE pSide10[static SPREAD_SIDE_COUNT]
+) {
+	ULONG ulState = gameRandGetStreamState(
+		GAME_RAND_DEFAULT_SEED, GAME_RAND_STREAM_SPREAD
+	);
+	BYTE *pSides[] = {pSide1, pSide2, pSide3, pSide10};
+	static const UBYTE pSpreads[] = {2, 4, 6, 20};
+	for(UBYTE ubTable = 0; ubTable < 4; ++ubTable) {
+		for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
+			ulState = gameRandNext(ulState);
+			pSides[ubTable][i] = -pSpreads[ubTable] / 2 + gameRandScale(
+				ulState >> 16, pSpreads[ubTable]
+			);
+		}
+	}
+}
+
+#endif // SURVIVOR_GAME_TABLES_CALC_H
@@ -5,13 +5,13 @@
 #include "perks.h"
 #include <ace/managers/key.h>
 #include <ace/managers/mouse.h>
-#include <ace/managers/rand.h>
 #include <ace/contrib/managers/audio_mixer.h>
 #include "comm/comm.h"
 #include "comm/button.h"
 #include "menu.h"
 #include "assets.h"
 #include "game.h"
+#include "game_rand.h"
 #include "survivor.h"
 
 
@@ -182,7 +182,7 @@ static void perksPrepareChoice(void) {
 		s_pPerkChoice[i] = PERK_COUNT;
 	}
 	while(s_ubChoiceCount < PERK_CHOICE_COUNT && s_ubChoiceCount < s_ubUnlockedPerkCount) {
-		tPerk ePickedPerk = s_pAvailablePerks[randUwMax(&g_sRand, PERK_COUNT - 1)];
+		tPerk ePickedPerk = s_pAvailablePerks[gameRandUwMax(GAME_RAND_STREAM_PERKS, PERK_COUNT - 1)];
 		if(ePickedPerk == PERK_COUNT) {
 			continue;
 		}
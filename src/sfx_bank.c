@@ -0,0 +1,97 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sfx_bank.h"
+#include <ace/managers/log.h>
+#include <ace/managers/memory.h>
+#include <ace/utils/disk_file.h>
+
+#define SFX_BANK_VERSION 2
+
+static ULONG sfxBankGetSize(UBYTE ubSfxCount) {
+	return sizeof(tSfxBank) + ubSfxCount * sizeof(tPtplayerSfx);
+}
+
+tSfxBank *sfxBankCreateFromFd(tFile *pFile, UBYTE isFast) {
+	logBlockBegin("sfxBankCreateFromFd(pFile: %p, isFast: %hhu)", pFile, isFast);
+	if(!pFile) {
+		logWrite("ERR: Null file handle\n");
+		logBlockEnd("sfxBankCreateFromFd()");
+		return 0;
+	}
+
+	// Version, sfx count, channel count samples were divided by
+	UBYTE pHeader[3];
+	if(fileRead(pFile, pHeader, sizeof(pHeader)) != sizeof(pHeader)) {
+		logWrite("ERR: Can't read header\n");
+		fileClose(pFile);
+		logBlockEnd("sfxBankCreateFromFd()");
+		return 0;
+	}
+	if(pHeader[0] != SFX_BANK_VERSION) {
+		logWrite("ERR: Unsupported version: %hhu\n", pHeader[0]);
+		fileClose(pFile);
+		logBlockEnd("sfxBankCreateFromFd()");
+		return 0;
+	}
+
+	UBYTE ubSfxCount = pHeader[1];
+	tSfxBank *pBank = memAllocFast(sfxBankGetSize(ubSfxCount));
+	pBank->ubSfxCount = ubSfxCount;
+	pBank->ubDivide = pHeader[2];
+	pBank->ulDataSize = 0;
+	UWORD *pWordLengths = memAllocFast(ubSfxCount * sizeof(UWORD));
+	if(
+		fileRead(pFile, pWordLengths, ubSfxCount * sizeof(UWORD)) !=
+		ubSfxCount * sizeof(UWORD)
+	) {
+		logWrite("ERR: Can't read sfx lengths\n");
+		memFree(pWordLengths, ubSfxCount * sizeof(UWORD));
+		memFree(pBank, sfxBankGetSize(ubSfxCount));
+		fileClose(pFile);
+		logBlockEnd("sfxBankCreateFromFd()");
+		return 0;
+	}
+	for(UBYTE i = 0; i < ubSfxCount; ++i) {
+		pBank->pSfxs[i] = (tPtplayerSfx){.uwWordLength = pWordLengths[i]};
+		pBank->ulDataSize += pWordLengths[i] * sizeof(UWORD);
+	}
+	memFree(pWordLengths, ubSfxCount * sizeof(UWORD));
+
+	pBank->pData = isFast ?
+		memAllocFast(pBank->ulDataSize) : memAllocChip(pBank->ulDataSize);
+	ULONG ulRead = fileRead(pFile, pBank->pData, pBank->ulDataSize);
+	fileClose(pFile);
+	if(ulRead != pBank->ulDataSize) {
+		logWrite(
+			"ERR: Sample data truncated: %lu of %lu bytes\n",
+			ulRead, pBank->ulDataSize
+		);
+		sfxBankDestroy(pBank);
+		logBlockEnd("sfxBankCreateFromFd()");
+		return 0;
+	}
+
+	UWORD *pSfxData = pBank->pData;
+	for(UBYTE i = 0; i < ubSfxCount; ++i) {
+		pBank->pSfxs[i].pData = pSfxData;
+		pSfxData += pBank->pSfxs[i].uwWordLength;
+	}
+
+	logWrite(
+		"Loaded %hhu sfx, %lu bytes, divided by %hhu\n",
+		ubSfxCount, pBank->ulDataSize, pBank->ubDivide
+	);
+	logBlockEnd("sfxBankCreateFromFd()");
+	return pBank;
+}
+
+tSfxBank *sfxBankCreateFromPath(const char *szPath, UBYTE isFast) {
+	return sfxBankCreateFromFd(diskFileOpen(szPath, DISK_FILE_MODE_READ, 1), isFast);
+}
+
+void sfxBankDestroy(tSfxBank *pBank) {
+	memFree(pBank->pData, pBank->ulDataSize);
+	memFree(pBank, sfxBankGetSize(pBank->ubSfxCount));
+}
@@ -0,0 +1,45 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_SFX_BANK_H
+#define SURVIVOR_SFX_BANK_H
+
+#include <ace/managers/ptplayer.h>
+#include <ace/utils/file.h>
+
+/**
+ * @brief Sound effects converted by tools/sfx_bank, sharing single data block.
+ */
+typedef struct tSfxBank {
+	UWORD *pData;
+	ULONG ulDataSize;
+	UBYTE ubSfxCount;
+	UBYTE ubDivide; ///< Samples fit in 8-bit mix of this many channels.
+	tPtplayerSfx pSfxs[]; ///< Point into pData, in bank's file order.
+} tSfxBank;
+
+/**
+ * @brief Loads whole sound bank with one read of its sample data.
+ * Samples are already padded & scaled for the mixer, so they're played
+ * as they are.
+ *
+ * @param szPath Path to bank file.
+ * @param isFast Set to 1 to load samples to fast RAM, which is enough for
+ * the mixer, otherwise they go to chip.
+ * @return Loaded bank, zero on failure.
+ */
+tSfxBank *sfxBankCreateFromPath(const char *szPath, UBYTE isFast);
+
+/**
+ * @brief Same as sfxBankCreateFromPath(), but reads from already opened file.
+ *
+ * @param pFile File positioned at bank's start, closed by this function.
+ * @param isFast Set to 1 to load samples to fast RAM.
+ * @return Loaded bank, zero on failure.
+ */
+tSfxBank *sfxBankCreateFromFd(tFile *pFile, UBYTE isFast);
+
+void sfxBankDestroy(tSfxBank *pBank);
+
+#endif // SURVIVOR_SFX_BANK_H
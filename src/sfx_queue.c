@@ -0,0 +1,124 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sfx_queue.h"
+#include <ace/contrib/managers/audio_mixer.h>
+#include "game_layout.h"
+#include "game_math.h"
+
+#define SFX_QUEUE_SIZE 8
+// Sounds this far beyond screen edge are still heard.
+#define SFX_QUEUE_CULL_MARGIN 64
+
+typedef struct tSfxRequest {
+	const tPtplayerSfx *pSfx;
+	UWORD uwDistance; ///< From the camera center.
+	UBYTE ubChannel;
+	UBYTE ubPriority;
+} tSfxRequest;
+
+static tSfxRequest s_pRequests[SFX_QUEUE_SIZE];
+static UBYTE s_ubRequestCount;
+static UBYTE s_ubChannelCount;
+static const tUwCoordYX *s_pCamPos;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static UBYTE sfxRequestIsBefore(const tSfxRequest *pA, const tSfxRequest *pB) {
+	if(pA->ubPriority != pB->ubPriority) {
+		return pA->ubPriority > pB->ubPriority;
+	}
+	return pA->uwDistance < pB->uwDistance;
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void sfxQueueReset(const tUwCoordYX *pCamPos) {
+	s_pCamPos = pCamPos;
+	s_ubRequestCount = 0;
+	s_ubChannelCount = audioMixerGetChannelCount();
+}
+
+void sfxQueueAdd(
+	const tPtplayerSfx *pSfx, UBYTE ubChannel, UBYTE ubPriority,
+	UWORD uwX, UWORD uwY
+) {
+	WORD wDx = uwX - (s_pCamPos->uwX + GAME_MAIN_VPORT_SIZE_X / 2);
+	WORD wDy = uwY - (s_pCamPos->uwY + GAME_MAIN_VPORT_SIZE_Y / 2);
+	UWORD uwDx = ABS(wDx);
+	UWORD uwDy = ABS(wDy);
+	if(
+		uwDx > GAME_MAIN_VPORT_SIZE_X / 2 + SFX_QUEUE_CULL_MARGIN ||
+		uwDy > GAME_MAIN_VPORT_SIZE_Y / 2 + SFX_QUEUE_CULL_MARGIN
+	) {
+		return;
+	}
+	UWORD uwDistance = fastMagnitude(uwDx, uwDy);
+
+	for(UBYTE i = 0; i < s_ubRequestCount; ++i) {
+		tSfxRequest *pRequest = &s_pRequests[i];
+		if(pRequest->pSfx == pSfx) {
+			// Same sample started twice in one frame is heard as one anyway
+			pRequest->uwDistance = MIN(pRequest->uwDistance, uwDistance);
+			return;
+		}
+	}
+
+	tSfxRequest *pRequest;
+	if(s_ubRequestCount < SFX_QUEUE_SIZE) {
+		pRequest = &s_pRequests[s_ubRequestCount++];
+	}
+	else {
+		// Replace least important one, if there's any
+		pRequest = &s_pRequests[0];
+		for(UBYTE i = 1; i < SFX_QUEUE_SIZE; ++i) {
+			if(sfxRequestIsBefore(pRequest, &s_pRequests[i])) {
+				pRequest = &s_pRequests[i];
+			}
+		}
+		tSfxRequest sNew = {.ubPriority = ubPriority, .uwDistance = uwDistance};
+		if(!sfxRequestIsBefore(&sNew, pRequest)) {
+			return;
+		}
+	}
+
+	pRequest->pSfx = pSfx;
+	pRequest->uwDistance = uwDistance;
+	pRequest->ubChannel = ubChannel;
+	pRequest->ubPriority = ubPriority;
+}
+
+void sfxQueueFlush(void) {
+	// Insertion sort - there are only a few requests per frame
+	for(UBYTE i = 1; i < s_ubRequestCount; ++i) {
+		tSfxRequest sRequest = s_pRequests[i];
+		UBYTE ubPos = i;
+		while(ubPos && sfxRequestIsBefore(&sRequest, &s_pRequests[ubPos - 1])) {
+			s_pRequests[ubPos] = s_pRequests[ubPos - 1];
+			--ubPos;
+		}
+		s_pRequests[ubPos] = sRequest;
+	}
+
+	UBYTE ubUsedChannels = 0;
+	UBYTE ubVoices = 0;
+	UBYTE ubExtraChannel = SFX_QUEUE_FIXED_CHANNEL_COUNT;
+	for(
+		UBYTE i = 0;
+		i < s_ubRequestCount && ubVoices < s_ubChannelCount; ++i
+	) {
+		const tSfxRequest *pRequest = &s_pRequests[i];
+		UBYTE ubChannel = pRequest->ubChannel;
+		if(ubUsedChannels & BV(ubChannel)) {
+			if(ubExtraChannel >= s_ubChannelCount) {
+				continue;
+			}
+			ubChannel = ubExtraChannel++;
+		}
+		ubUsedChannels |= BV(ubChannel);
+		audioMixerPlaySfx(pRequest->pSfx, ubChannel, pRequest->ubPriority, 0);
+		++ubVoices;
+	}
+	s_ubRequestCount = 0;
+}
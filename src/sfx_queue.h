@@ -0,0 +1,45 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_SFX_QUEUE_H
+#define SURVIVOR_SFX_QUEUE_H
+
+#include <ace/managers/ptplayer.h>
+
+// Channels used by the game. Mixer builds with more software channels use the
+// extra ones for sounds whose channel was already taken in given frame.
+#define SFX_QUEUE_FIXED_CHANNEL_COUNT 3
+
+/**
+ * @brief Drops all pending sound requests. Call after mixer is created.
+ *
+ * @param pCamPos Top-left position of the camera, read on each request.
+ */
+void sfxQueueReset(const tUwCoordYX *pCamPos);
+
+/**
+ * @brief Requests sound playback at the end of current frame.
+ * Requests far off-screen are dropped. Requests for the same sound in one
+ * frame are merged into one, ranked by position closest to the camera.
+ *
+ * @param pSfx Sound effect to play.
+ * @param ubChannel Mixer's software channel to play on.
+ * @param ubPriority Bigger is more important, passed to mixer as well.
+ * @param uwX Sound source position on map, used for culling & ranking.
+ * @param uwY Ditto, Y.
+ */
+void sfxQueueAdd(
+	const tPtplayerSfx *pSfx, UBYTE ubChannel, UBYTE ubPriority,
+	UWORD uwX, UWORD uwY
+);
+
+/**
+ * @brief Plays pending requests, most important & then closest first.
+ * Mixer is called at most once per its software channel. Requests landing on
+ * channel already used in this frame go to the extra channels, if there are
+ * any, or get dropped. Call before camera gets moved.
+ */
+void sfxQueueFlush(void);
+
+#endif // SURVIVOR_SFX_QUEUE_H
@@ -0,0 +1,113 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sfx_sequence.h"
+#include <ace/macros.h>
+#include <ace/managers/memory.h>
+#include <ace/contrib/managers/audio_mixer.h>
+
+// Gaps are played as repeated silence chunks, so that long gaps won't take
+// much of chip.
+#define SFX_SEQUENCE_SILENCE_SIZE 512
+
+typedef struct tSfxSequencePlayback {
+	const tSfxSequence * volatile pSequence; ///< Zero when inactive.
+	const UWORD *pPlayedData; ///< Data of currently played step or gap.
+	tPtplayerSfx sGap;
+	UWORD uwGapLeft;
+	WORD wPriority;
+	UBYTE ubStep;
+} tSfxSequencePlayback;
+
+static tSfxSequencePlayback s_pPlaybacks[SFX_SEQUENCE_CHANNEL_COUNT];
+static UWORD *s_pSilence;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static void sfxSequencePlayStep(
+	tSfxSequencePlayback *pPlayback, const tSfxSequence *pSequence,
+	UBYTE ubChannel
+) {
+	const tSfxSequenceStep *pStep = &pSequence->pSteps[pPlayback->ubStep];
+	pPlayback->uwGapLeft = pStep->uwGapLength;
+	pPlayback->pPlayedData = pStep->pSfx->pData;
+	audioMixerPlaySfx(pStep->pSfx, ubChannel, pPlayback->wPriority, 0);
+}
+
+static void sfxSequencePlayGap(tSfxSequencePlayback *pPlayback, UBYTE ubChannel) {
+	UWORD uwLength = MIN(pPlayback->uwGapLeft, SFX_SEQUENCE_SILENCE_SIZE);
+	pPlayback->uwGapLeft -= uwLength;
+	pPlayback->sGap.uwWordLength = uwLength / sizeof(UWORD);
+	pPlayback->pPlayedData = s_pSilence;
+	audioMixerPlaySfx(&pPlayback->sGap, ubChannel, pPlayback->wPriority, 0);
+}
+
+// Called from mixer's interrupt.
+static UBYTE sfxSequenceOnSfxEnd(UBYTE ubChannel, const UWORD *pData) {
+	if(ubChannel >= SFX_SEQUENCE_CHANNEL_COUNT) {
+		return 0;
+	}
+	tSfxSequencePlayback *pPlayback = &s_pPlaybacks[ubChannel];
+	const tSfxSequence *pSequence = pPlayback->pSequence;
+	if(!pSequence) {
+		return 0;
+	}
+	if(pData != pPlayback->pPlayedData) {
+		// Other sound took over the channel - its end doesn't advance sequence
+		return 0;
+	}
+
+	if(pPlayback->uwGapLeft) {
+		sfxSequencePlayGap(pPlayback, ubChannel);
+		return 1;
+	}
+
+	if(++pPlayback->ubStep >= pSequence->ubStepCount) {
+		if(!pSequence->isLoop) {
+			pPlayback->pSequence = 0;
+			return 0;
+		}
+		pPlayback->ubStep = 0;
+	}
+	sfxSequencePlayStep(pPlayback, pSequence, ubChannel);
+	return 1;
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void sfxSequenceCreate(void) {
+	s_pSilence = memAllocChipClear(SFX_SEQUENCE_SILENCE_SIZE);
+	for(UBYTE i = 0; i < SFX_SEQUENCE_CHANNEL_COUNT; ++i) {
+		s_pPlaybacks[i] = (tSfxSequencePlayback){.sGap = {.pData = s_pSilence}};
+	}
+	audioMixerSetSfxEndCallback(sfxSequenceOnSfxEnd);
+}
+
+void sfxSequenceDestroy(void) {
+	for(UBYTE i = 0; i < SFX_SEQUENCE_CHANNEL_COUNT; ++i) {
+		sfxSequenceStop(i);
+	}
+	audioMixerSetSfxEndCallback(0);
+	memFree(s_pSilence, SFX_SEQUENCE_SILENCE_SIZE);
+}
+
+void sfxSequencePlay(
+	const tSfxSequence *pSequence, UBYTE ubChannel, WORD wPriority
+) {
+	tSfxSequencePlayback *pPlayback = &s_pPlaybacks[ubChannel];
+	pPlayback->pSequence = 0;
+	pPlayback->wPriority = wPriority;
+	pPlayback->ubStep = 0;
+	sfxSequencePlayStep(pPlayback, pSequence, ubChannel);
+	// Callback may now advance it
+	pPlayback->pSequence = pSequence;
+}
+
+void sfxSequenceStop(UBYTE ubChannel) {
+	tSfxSequencePlayback *pPlayback = &s_pPlaybacks[ubChannel];
+	if(pPlayback->pSequence) {
+		pPlayback->pSequence = 0;
+		audioMixerStopSfxOnChannel(ubChannel);
+	}
+}
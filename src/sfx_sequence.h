@@ -0,0 +1,58 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_SFX_SEQUENCE_H
+#define SURVIVOR_SFX_SEQUENCE_H
+
+#include <ace/managers/ptplayer.h>
+
+#define SFX_SEQUENCE_CHANNEL_COUNT 3
+#define SFX_SEQUENCE_SAMPLE_RATE (3546895 / GAME_AUDIO_MIXER_PERIOD)
+// Mixer is set up for sample lengths being multiple of 32 bytes.
+#define SFX_SEQUENCE_GAP_FROM_MS(ms) ( \
+	((ULONG)(ms) * SFX_SEQUENCE_SAMPLE_RATE / 1000 + 31) & ~31 \
+)
+
+typedef struct tSfxSequenceStep {
+	const tPtplayerSfx *pSfx;
+	UWORD uwGapLength; ///< Silence after the sound, in samples.
+} tSfxSequenceStep;
+
+typedef struct tSfxSequence {
+	const tSfxSequenceStep *pSteps;
+	UBYTE ubStepCount;
+	UBYTE isLoop; ///< Restart from first step after the last one.
+} tSfxSequence;
+
+/**
+ * @brief Sets up mixer's sample end callback which advances the sequences.
+ */
+void sfxSequenceCreate(void);
+
+/**
+ * @brief Stops all sequences & removes mixer's sample end callback.
+ */
+void sfxSequenceDestroy(void);
+
+/**
+ * @brief Starts playing sequence on given mixer channel.
+ * Next steps are started by the mixer's interrupt right as previous sound
+ * or gap ends, so the timing doesn't depend on game's frame rate.
+ * If other sound takes over the channel, sequence stalls until it's stopped
+ * or played again.
+ *
+ * @param pSequence Sequence to play, must be valid until it's stopped.
+ * @param ubChannel Mixer's software channel to play on.
+ * @param wPriority Mixer priority of all sequence's sounds.
+ */
+void sfxSequencePlay(
+	const tSfxSequence *pSequence, UBYTE ubChannel, WORD wPriority
+);
+
+/**
+ * @brief Stops sequence on given channel along with any sound played on it.
+ */
+void sfxSequenceStop(UBYTE ubChannel);
+
+#endif // SURVIVOR_SFX_SEQUENCE_H
@@ -15,6 +15,7 @@
 #include "game.h"
 #include "fade.h"
 #include "survivor.h"
+#include "asset_archive.h"
 
 #define FLASH_START_FRAME_A 1
 #define FLASH_START_FRAME_C 10
@@ -108,6 +109,7 @@ static void splashGsLoop(void) {
 		s_isEscapePressed = keyUse(KEY_ESCAPE);
 	}
 
+	assetArchivePrefetchProcess();
 	stateProcess(s_pStateMachineSplash);
 }
 
@@ -140,9 +142,11 @@ static void onLmcFadeOut(void)
 static void splashLmcCreate(void) {
 	systemUse();
 	UWORD pPaletteRef[32];
-	paletteLoadFromPath("data/splash/lmc.plt", pPaletteRef, 1 << s_pVp->ubBpp);
-	tBitMap *pSplash = bitmapCreateFromPath("data/splash/lmc.bm", 0);
-	s_pSfxLmc = ptplayerSfxCreateFromPath("data/splash/lmc.sfx", 0);
+	paletteLoadFromFd(assetArchiveOpen("splash/lmc.plt", 0), pPaletteRef, 1 << s_pVp->ubBpp);
+	tBitMap *pSplash = assetArchiveBitmapCreate("splash/lmc.bm");
+	s_pSfxLmc = ptplayerSfxCreateFromFd(assetArchiveOpen("splash/lmc.sfx", 0), 0);
+	// Splash screens are mostly idle, so next assets can be read meanwhile
+	assetArchivePrefetchStart();
 	systemUnuse();
 
 	s_sSplashRect.uwWidth = bitmapGetByteWidth(pSplash) * 8;
@@ -222,7 +226,7 @@ static UWORD blendColors(UWORD uwColorSrc, UWORD uwColorDst, UBYTE ubRatio)
 static void splashAceCreate(void) {
 	systemUse();
 
-	tBitMap *pSplashAce = bitmapCreateFromPath("data/splash/ace.bm", 0);
+	tBitMap *pSplashAce = assetArchiveBitmapCreate("splash/ace.bm");
 	s_sSplashRect.uwWidth = bitmapGetByteWidth(pSplashAce) * 8;
 	s_sSplashRect.uwHeight = pSplashAce->Rows;
 	UWORD uwSplashOffsY = (256 - s_sSplashRect.uwHeight) / 2;
@@ -240,7 +244,7 @@ static void splashAceCreate(void) {
 	s_bRatioFlashE = FLASH_RATIO_INACTIVE;
 	s_bRatioFlashPwr = FLASH_RATIO_INACTIVE;
 
-	s_pSfxAce = ptplayerSfxCreateFromPath("data/splash/ace.sfx", 0);
+	s_pSfxAce = ptplayerSfxCreateFromFd(assetArchiveOpen("splash/ace.sfx", 0), 0);
 	systemUnuse();
 
 	blitCopy(
@@ -0,0 +1,248 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sprite_mux.h"
+#include <ace/managers/copper.h>
+#include <ace/managers/memory.h>
+#include <ace/managers/log.h>
+#include <ace/utils/chunky.h>
+#include <ace/utils/custom.h>
+
+// Attached pairs: channel 4 is used by cursor, so 4/5 can't be attached.
+#define SPRITE_MUX_LANE_COUNT 3
+#define SPRITE_MUX_SLOTS_PER_LANE 4
+#define SPRITE_MUX_CHAIN_WORDS (SPRITE_MUX_SLOTS_PER_LANE * (2 + 2 * SPRITE_MUX_SIZE_Y_MAX) + 2)
+#define SPRITE_MUX_COLOR_FIRST 16
+#define SPRITE_MUX_SOURCE_COLORS 32
+
+typedef struct tSpriteMuxSlot {
+	const tSpriteMuxFrame *pFrame;
+	UWORD uwHStart;
+	UWORD uwVStart;
+} tSpriteMuxSlot;
+
+typedef struct tSpriteMuxLane {
+	UBYTE ubChannel; ///< Even channel, odd one is ubChannel + 1.
+	UBYTE ubSlotCount;
+	UWORD uwNextFreeLine;
+	UWORD *pChainsEven[2];
+	UWORD *pChainsOdd[2];
+	tSpriteMuxSlot pSlots[SPRITE_MUX_SLOTS_PER_LANE];
+} tSpriteMuxLane;
+
+static const UBYTE s_pLaneChannels[SPRITE_MUX_LANE_COUNT] = {0, 2, 6};
+
+static tSpriteMuxLane s_pLanes[SPRITE_MUX_LANE_COUNT];
+static tView *s_pView;
+static UWORD s_uwRawCopPos;
+static UWORD s_uwDisplayTop;
+static UWORD s_uwDisplayHeight;
+static UWORD *s_pBlankChain;
+static UBYTE s_ubBufferCurr;
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static void spriteMuxSetPointer(tCopBfr *pCopBfr, UBYTE ubChannel, UWORD *pChain) {
+	ULONG ulAddr = (ULONG)pChain;
+	tCopCmd *pCmds = &pCopBfr->pList[s_uwRawCopPos + ubChannel * 2];
+	copSetMove(&pCmds[0].sMove, &g_pSprFetch[ubChannel].uwHi, ulAddr >> 16);
+	copSetMove(&pCmds[1].sMove, &g_pSprFetch[ubChannel].uwLo, ulAddr & 0xFFFF);
+}
+
+__attribute__((always_inline))
+static inline UWORD *spriteMuxWriteCtl(
+	UWORD *pChain, UWORD uwHStart, UWORD uwVStart, UWORD uwVStop, UBYTE isAttached
+) {
+	*(pChain++) = ((uwVStart & 0xFF) << 8) | ((uwHStart >> 1) & 0xFF);
+	*(pChain++) = (
+		((uwVStop & 0xFF) << 8) | (isAttached ? BV(7) : 0) |
+		((uwVStart >> 8) & 1) << 2 | ((uwVStop >> 8) & 1) << 1 | (uwHStart & 1)
+	);
+	return pChain;
+}
+
+static UBYTE spriteMuxGetClosestColor(const UWORD *pPalette, UBYTE ubColor) {
+	if(ubColor > SPRITE_MUX_COLOR_FIRST) {
+		// Shared with playfield, can be used as-is.
+		return ubColor - SPRITE_MUX_COLOR_FIRST;
+	}
+
+	WORD wR = (pPalette[ubColor] >> 8) & 0xF;
+	WORD wG = (pPalette[ubColor] >> 4) & 0xF;
+	WORD wB = (pPalette[ubColor] >> 0) & 0xF;
+	UBYTE ubBest = 1;
+	UWORD uwBestDistance = 0xFFFF;
+	for(UBYTE ubValue = 1; ubValue < 16; ++ubValue) {
+		UWORD uwCandidate = pPalette[SPRITE_MUX_COLOR_FIRST + ubValue];
+		WORD wDr = ((uwCandidate >> 8) & 0xF) - wR;
+		WORD wDg = ((uwCandidate >> 4) & 0xF) - wG;
+		WORD wDb = ((uwCandidate >> 0) & 0xF) - wB;
+		UWORD uwDistance = wDr * wDr + wDg * wDg + wDb * wDb;
+		if(uwDistance < uwBestDistance) {
+			uwBestDistance = uwDistance;
+			ubBest = ubValue;
+		}
+	}
+	return ubBest;
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+void spriteMuxCreate(
+	tView *pView, UWORD uwRawCopPos, UWORD uwDisplayTop, UWORD uwDisplayHeight
+) {
+	logBlockBegin(
+		"spriteMuxCreate(pView: %p, uwRawCopPos: %hu, uwDisplayTop: %hu, uwDisplayHeight: %hu)",
+		pView, uwRawCopPos, uwDisplayTop, uwDisplayHeight
+	);
+	s_pView = pView;
+	s_uwRawCopPos = uwRawCopPos;
+	s_uwDisplayTop = uwDisplayTop;
+	s_uwDisplayHeight = uwDisplayHeight;
+	s_ubBufferCurr = 0;
+
+	s_pBlankChain = memAllocChipClear(2 * sizeof(UWORD));
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		tSpriteMuxLane *pLane = &s_pLanes[ubLane];
+		pLane->ubChannel = s_pLaneChannels[ubLane];
+		pLane->ubSlotCount = 0;
+		pLane->uwNextFreeLine = 0;
+		for(UBYTE ubBuffer = 0; ubBuffer < 2; ++ubBuffer) {
+			pLane->pChainsEven[ubBuffer] = memAllocChipClear(SPRITE_MUX_CHAIN_WORDS * sizeof(UWORD));
+			pLane->pChainsOdd[ubBuffer] = memAllocChipClear(SPRITE_MUX_CHAIN_WORDS * sizeof(UWORD));
+		}
+	}
+	spriteMuxHide();
+	logBlockEnd("spriteMuxCreate()");
+}
+
+void spriteMuxDestroy(void) {
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		tSpriteMuxLane *pLane = &s_pLanes[ubLane];
+		for(UBYTE ubBuffer = 0; ubBuffer < 2; ++ubBuffer) {
+			memFree(pLane->pChainsEven[ubBuffer], SPRITE_MUX_CHAIN_WORDS * sizeof(UWORD));
+			memFree(pLane->pChainsOdd[ubBuffer], SPRITE_MUX_CHAIN_WORDS * sizeof(UWORD));
+		}
+	}
+	memFree(s_pBlankChain, 2 * sizeof(UWORD));
+}
+
+void spriteMuxFrameCreate(
+	tSpriteMuxFrame *pFrame, const tBitMap *pFrames, const tBitMap *pMasks,
+	UWORD uwOffsY, UBYTE ubHeight, const UWORD *pPalette
+) {
+	UBYTE pValueFromColor[SPRITE_MUX_SOURCE_COLORS];
+	for(UBYTE ubColor = 0; ubColor < SPRITE_MUX_SOURCE_COLORS; ++ubColor) {
+		pValueFromColor[ubColor] = spriteMuxGetClosestColor(pPalette, ubColor);
+	}
+
+	pFrame->ubHeight = ubHeight;
+	pFrame->pEven = memAllocFast(ubHeight * 2 * sizeof(UWORD));
+	pFrame->pOdd = memAllocFast(ubHeight * 2 * sizeof(UWORD));
+	UWORD *pEven = pFrame->pEven;
+	UWORD *pOdd = pFrame->pOdd;
+	for(UBYTE ubY = 0; ubY < ubHeight; ++ubY) {
+		UBYTE pColors[SPRITE_MUX_SIZE_X];
+		chunkyFromPlanar16(pFrames, 0, uwOffsY + ubY, pColors);
+		UWORD uwMask = *(UWORD*)&pMasks->Planes[0][(uwOffsY + ubY) * pMasks->BytesPerRow];
+		UWORD pPlanes[4] = {0};
+		for(UBYTE ubX = 0; ubX < SPRITE_MUX_SIZE_X; ++ubX) {
+			UBYTE ubValue = 0;
+			if(uwMask & BV(15 - ubX)) {
+				ubValue = pValueFromColor[pColors[ubX]];
+			}
+			for(UBYTE ubPlane = 0; ubPlane < 4; ++ubPlane) {
+				pPlanes[ubPlane] = (pPlanes[ubPlane] << 1) | ((ubValue >> ubPlane) & 1);
+			}
+		}
+		*(pEven++) = pPlanes[0];
+		*(pEven++) = pPlanes[1];
+		*(pOdd++) = pPlanes[2];
+		*(pOdd++) = pPlanes[3];
+	}
+}
+
+void spriteMuxFrameDestroy(tSpriteMuxFrame *pFrame) {
+	memFree(pFrame->pEven, pFrame->ubHeight * 2 * sizeof(UWORD));
+	memFree(pFrame->pOdd, pFrame->ubHeight * 2 * sizeof(UWORD));
+}
+
+void spriteMuxBegin(void) {
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		s_pLanes[ubLane].ubSlotCount = 0;
+		s_pLanes[ubLane].uwNextFreeLine = 0;
+	}
+}
+
+UBYTE spriteMuxPush(const tSpriteMuxFrame *pFrame, WORD wX, WORD wY) {
+	if(
+		wX <= -SPRITE_MUX_SIZE_X || wX >= s_pView->uwWidth ||
+		wY <= -pFrame->ubHeight || wY >= (WORD)s_uwDisplayHeight
+	) {
+		// Not visible at all - nothing to draw
+		return 1;
+	}
+	if(wY < 0 || wY + pFrame->ubHeight > s_uwDisplayHeight) {
+		// Sprites aren't clipped by viewport, so let bob handle it
+		return 0;
+	}
+
+	UWORD uwVStart = s_uwDisplayTop + wY;
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		tSpriteMuxLane *pLane = &s_pLanes[ubLane];
+		if(
+			pLane->ubSlotCount < SPRITE_MUX_SLOTS_PER_LANE &&
+			uwVStart >= pLane->uwNextFreeLine
+		) {
+			tSpriteMuxSlot *pSlot = &pLane->pSlots[pLane->ubSlotCount++];
+			pSlot->pFrame = pFrame;
+			pSlot->uwHStart = s_pView->ubPosX - 1 + wX;
+			pSlot->uwVStart = uwVStart;
+			// Sprite DMA needs a blank line after VSTOP to fetch next control words
+			pLane->uwNextFreeLine = uwVStart + pFrame->ubHeight + 1;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void spriteMuxEnd(void) {
+	tCopBfr *pCopBfr = s_pView->pCopList->pBackBfr;
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		tSpriteMuxLane *pLane = &s_pLanes[ubLane];
+		UWORD *pEven = pLane->pChainsEven[s_ubBufferCurr];
+		UWORD *pOdd = pLane->pChainsOdd[s_ubBufferCurr];
+		for(UBYTE ubSlot = 0; ubSlot < pLane->ubSlotCount; ++ubSlot) {
+			const tSpriteMuxSlot *pSlot = &pLane->pSlots[ubSlot];
+			const tSpriteMuxFrame *pFrame = pSlot->pFrame;
+			UWORD uwVStop = pSlot->uwVStart + pFrame->ubHeight;
+			pEven = spriteMuxWriteCtl(pEven, pSlot->uwHStart, pSlot->uwVStart, uwVStop, 0);
+			pOdd = spriteMuxWriteCtl(pOdd, pSlot->uwHStart, pSlot->uwVStart, uwVStop, 1);
+			const ULONG *pSrcEven = (const ULONG*)pFrame->pEven;
+			const ULONG *pSrcOdd = (const ULONG*)pFrame->pOdd;
+			for(UBYTE ubY = pFrame->ubHeight; ubY--;) {
+				*((ULONG*)pEven) = *(pSrcEven++);
+				*((ULONG*)pOdd) = *(pSrcOdd++);
+				pEven += 2;
+				pOdd += 2;
+			}
+		}
+		*((ULONG*)pEven) = 0;
+		*((ULONG*)pOdd) = 0;
+
+		spriteMuxSetPointer(pCopBfr, pLane->ubChannel, pLane->pChainsEven[s_ubBufferCurr]);
+		spriteMuxSetPointer(pCopBfr, pLane->ubChannel + 1, pLane->pChainsOdd[s_ubBufferCurr]);
+	}
+	s_ubBufferCurr = !s_ubBufferCurr;
+}
+
+void spriteMuxHide(void) {
+	for(UBYTE ubLane = 0; ubLane < SPRITE_MUX_LANE_COUNT; ++ubLane) {
+		UBYTE ubChannel = s_pLanes[ubLane].ubChannel;
+		spriteMuxSetPointer(s_pView->pCopList->pFrontBfr, ubChannel, s_pBlankChain);
+		spriteMuxSetPointer(s_pView->pCopList->pFrontBfr, ubChannel + 1, s_pBlankChain);
+		spriteMuxSetPointer(s_pView->pCopList->pBackBfr, ubChannel, s_pBlankChain);
+		spriteMuxSetPointer(s_pView->pCopList->pBackBfr, ubChannel + 1, s_pBlankChain);
+	}
+}
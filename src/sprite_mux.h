@@ -0,0 +1,89 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_SPRITE_MUX_H
+#define SURVIVOR_SPRITE_MUX_H
+
+#include <ace/utils/extview.h>
+#include <ace/utils/bitmap.h>
+
+#define SPRITE_MUX_SIZE_X 16
+#define SPRITE_MUX_SIZE_Y_MAX 16
+
+/**
+ * @brief Bob frame converted to a 15-color attached sprite pair.
+ * Rows are stored as they're fetched by sprite DMA: two words per row,
+ * even channel holding bitplanes 0 & 1, odd channel bitplanes 2 & 3.
+ */
+typedef struct tSpriteMuxFrame {
+	UWORD *pEven;
+	UWORD *pOdd;
+	UBYTE ubHeight;
+} tSpriteMuxFrame;
+
+/**
+ * @brief Sets up sprite chains on channels not used by the cursor.
+ * Must be called after spriteManagerCreate(), since it takes over
+ * the sprite pointer moves of its channels in raw copperlist.
+ *
+ * @param pView View with raw copperlist.
+ * @param uwRawCopPos Copperlist position of sprite pointer moves,
+ * same as passed to spriteManagerCreate().
+ * @param uwDisplayTop Vertical beam position of first line on which muxed
+ * sprites may be displayed.
+ * @param uwDisplayHeight Height of area on which muxed sprites are displayed.
+ */
+void spriteMuxCreate(
+	tView *pView, UWORD uwRawCopPos, UWORD uwDisplayTop, UWORD uwDisplayHeight
+);
+
+void spriteMuxDestroy(void);
+
+/**
+ * @brief Converts 16px wide bob frame into sprite data.
+ * Pixels are remapped onto sprite colors 17..31 - colors which are shared
+ * with the playfield are kept as-is, others use the closest sprite color.
+ *
+ * @param pFrame Frame to be filled.
+ * @param pFrames Interleaved bob frame bitmap.
+ * @param pMasks Interleaved bob mask bitmap.
+ * @param uwOffsY Y offset of frame in bitmaps.
+ * @param ubHeight Height of frame, up to SPRITE_MUX_SIZE_Y_MAX.
+ * @param pPalette Palette used by playfield.
+ */
+void spriteMuxFrameCreate(
+	tSpriteMuxFrame *pFrame, const tBitMap *pFrames, const tBitMap *pMasks,
+	UWORD uwOffsY, UBYTE ubHeight, const UWORD *pPalette
+);
+
+void spriteMuxFrameDestroy(tSpriteMuxFrame *pFrame);
+
+void spriteMuxBegin(void);
+
+/**
+ * @brief Tries to display given frame on next free sprite channel pair.
+ * Channels are reused vertically, so pushes should be done in ascending
+ * Y order for best channel usage.
+ *
+ * @param pFrame Frame to be displayed.
+ * @param wX X position relative to display area.
+ * @param wY Y position relative to display area.
+ * @return 1 if frame is handled by sprites, 0 if caller should fall back
+ * to bob.
+ */
+UBYTE spriteMuxPush(const tSpriteMuxFrame *pFrame, WORD wX, WORD wY);
+
+/**
+ * @brief Builds sprite chains for pushed frames & points back copperlist
+ * at them. Call before copSwapBuffers().
+ */
+void spriteMuxEnd(void);
+
+/**
+ * @brief Hides muxed sprites on both copperlists, e.g. when gameplay
+ * is covered by menus.
+ */
+void spriteMuxHide(void);
+
+#endif // SURVIVOR_SPRITE_MUX_H
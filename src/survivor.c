@@ -12,6 +12,8 @@
 #include "cutscene.h"
 #include "splash.h"
 #include "assets.h"
+#include "audio_tier.h"
+#include "asset_archive.h"
 
 tStateManager *g_pGameStateManager;
 
@@ -24,8 +26,10 @@ void genericCreate(void) {
 	ptplayerCreate(1);
 	ptplayerSetChannelsForPlayer(0b0111);
 	ptplayerSetMasterVolume(PTPLAYER_MASTER_VOLUME);
+	audioTierSelect();
 	audioMixerCreate();
 
+	assetArchiveCreate("data/game.pak");
 	assetsGlobalCreate();
 	statePush(g_pGameStateManager, &g_sStateSplash);
 	// statePush(g_pGameStateManager, &g_sStateCutscene);
@@ -44,6 +48,7 @@ void genericDestroy(void) {
 	ptplayerDestroy();
 
 	assetsGlobalDestroy();
+	assetArchiveDestroy();
 	keyDestroy();
 	mouseDestroy();
 }
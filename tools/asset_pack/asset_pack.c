@@ -0,0 +1,472 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Host-side packer of game's data files into single archive read by
+// src/asset_archive.c. Files are stored in the order given, which should be
+// the game's load order, so that loading them is one long sequential read.
+// Files with extension given by -lz are compressed with src/asset_lz.h
+// format, if that makes them smaller. Each compressed file is decompressed
+// back with game's decompressor and compared with the original.
+// Files given with MASK: prefix are ACE bitmaps of bob masks, with the same
+// data on each plane. After checking that, only their first plane is stored
+// as 1 bpp bitmap, to be repeated on each plane by the game at load time.
+// Build: cc -std=c11 -O2 -DASSET_LZ_HOST -I src asset_pack.c src/asset_lz.c
+// Usage: asset_pack [-lz .ext] out.pak base_dir CHIP|FAST|MASK:name...
+//
+// Archive layout, big-endian:
+//   UBYTE ubVersion, UBYTE ubReserved, UWORD uwEntryCount
+//   entries, 44 bytes each:
+//     char szName[30] (zero-terminated), UBYTE ubMemType (0: chip, 1: fast),
+//     UBYTE ubFlags (bit 0: compressed), ULONG ulOffset (from archive start),
+//     ULONG ulSize (decompressed), ULONG ulPackedSize (as stored)
+//   file contents, one after another, without padding so that reading files
+//   in archive's order needs no seeks
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "asset_lz.h"
+
+typedef int32_t LONG;
+
+#define ASSET_PACK_VERSION 2
+#define ASSET_PACK_ENTRIES_MAX 255
+#define ASSET_PACK_NAME_SIZE 30
+#define ASSET_PACK_HEADER_SIZE 4
+#define ASSET_PACK_ENTRY_SIZE 44
+#define ASSET_PACK_MEM_CHIP 0
+#define ASSET_PACK_MEM_FAST 1
+#define ASSET_PACK_FLAG_LZ 1
+#define ASSET_PACK_HASH_BITS 16
+// ACE bitmap file: UWORD uwWidth, UWORD uwHeight, UBYTE ubBpp, UBYTE ubVersion,
+// UBYTE ubFlags, 2 unused bytes
+#define ASSET_PACK_BM_HEADER_SIZE 9
+#define ASSET_PACK_BM_FLAG_INTERLEAVED 1
+#define ASSET_PACK_CHAIN_MAX 256
+
+typedef struct tEntry {
+	const char *szName;
+	UBYTE ubMemType;
+	UBYTE ubFlags;
+	UBYTE *pData; ///< Data as stored, compressed or not.
+	ULONG ulSize;
+	ULONG ulPackedSize;
+	ULONG ulOffset;
+} tEntry;
+
+typedef struct tMemReader {
+	const UBYTE *pData;
+	ULONG ulLeft;
+	ULONG ulChunk; ///< Max bytes returned per read, to test streaming.
+} tMemReader;
+
+static UBYTE *readFile(const char *szPath, ULONG *pSize) {
+	FILE *pFile = fopen(szPath, "rb");
+	if(!pFile) {
+		return 0;
+	}
+	fseek(pFile, 0, SEEK_END);
+	long lSize = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+	UBYTE *pData = malloc(lSize ? lSize : 1);
+	if(pData && fread(pData, 1, lSize, pFile) != (size_t)lSize) {
+		free(pData);
+		pData = 0;
+	}
+	fclose(pFile);
+	*pSize = lSize;
+	return pData;
+}
+
+static ULONG lzHash(const UBYTE *pData) {
+	ULONG ulValue = (
+		pData[0] | (pData[1] << 8) | (pData[2] << 16) | ((ULONG)pData[3] << 24)
+	);
+	return (ulValue * 2654435761u) >> (32 - ASSET_PACK_HASH_BITS);
+}
+
+static void lzWriteLength(UBYTE **pOut, ULONG ulLength) {
+	while(ulLength >= ASSET_LZ_EXTENSION_MAX) {
+		*((*pOut)++) = ASSET_LZ_EXTENSION_MAX;
+		ulLength -= ASSET_LZ_EXTENSION_MAX;
+	}
+	*((*pOut)++) = ulLength;
+}
+
+// Match length of zero means last sequence, ending after its literals.
+static void lzWriteSequence(
+	UBYTE **pOut, const UBYTE *pLiterals, ULONG ulLiteralCount,
+	ULONG ulMatchLength, ULONG ulDistance
+) {
+	ULONG ulMatchCode = ulMatchLength ? ulMatchLength - ASSET_LZ_MATCH_MIN : 0;
+	UBYTE ubLiteralNibble = (
+		ulLiteralCount < ASSET_LZ_NIBBLE_MAX ? ulLiteralCount : ASSET_LZ_NIBBLE_MAX
+	);
+	UBYTE ubMatchNibble = (
+		ulMatchCode < ASSET_LZ_NIBBLE_MAX ? ulMatchCode : ASSET_LZ_NIBBLE_MAX
+	);
+	*((*pOut)++) = (ubLiteralNibble << 4) | ubMatchNibble;
+	if(ubLiteralNibble == ASSET_LZ_NIBBLE_MAX) {
+		lzWriteLength(pOut, ulLiteralCount - ASSET_LZ_NIBBLE_MAX);
+	}
+	memcpy(*pOut, pLiterals, ulLiteralCount);
+	*pOut += ulLiteralCount;
+	if(!ulMatchLength) {
+		return;
+	}
+	*((*pOut)++) = (ulDistance - 1) >> 8;
+	*((*pOut)++) = (ulDistance - 1) & 0xFF;
+	if(ubMatchNibble == ASSET_LZ_NIBBLE_MAX) {
+		lzWriteLength(pOut, ulMatchCode - ASSET_LZ_NIBBLE_MAX);
+	}
+}
+
+// Greedy compression with hash chains. Returns compressed data, which may
+// be larger than the source.
+static UBYTE *lzCompress(const UBYTE *pSrc, ULONG ulSize, ULONG *pPackedSize) {
+	UBYTE *pPacked = malloc(ulSize + ulSize / ASSET_LZ_EXTENSION_MAX + 16);
+	LONG *pHeads = malloc((1 << ASSET_PACK_HASH_BITS) * sizeof(LONG));
+	LONG *pPrevs = malloc((ulSize ? ulSize : 1) * sizeof(LONG));
+	if(!pPacked || !pHeads || !pPrevs) {
+		free(pPacked);
+		free(pHeads);
+		free(pPrevs);
+		return 0;
+	}
+	for(ULONG i = 0; i < (1 << ASSET_PACK_HASH_BITS); ++i) {
+		pHeads[i] = -1;
+	}
+
+	UBYTE *pOut = pPacked;
+	ULONG ulLiteralStart = 0;
+	ULONG ulPos = 0;
+	while(ulPos + ASSET_LZ_MATCH_MIN <= ulSize) {
+		ULONG ulHash = lzHash(&pSrc[ulPos]);
+		ULONG ulBestLength = 0, ulBestDistance = 0;
+		LONG lCandidate = pHeads[ulHash];
+		for(
+			UWORD uwDepth = 0;
+			lCandidate >= 0 && ulPos - lCandidate <= ASSET_LZ_WINDOW_SIZE &&
+			uwDepth < ASSET_PACK_CHAIN_MAX;
+			++uwDepth, lCandidate = pPrevs[lCandidate]
+		) {
+			ULONG ulLength = 0;
+			while(
+				ulPos + ulLength < ulSize &&
+				pSrc[lCandidate + ulLength] == pSrc[ulPos + ulLength]
+			) {
+				++ulLength;
+			}
+			if(ulLength > ulBestLength) {
+				ulBestLength = ulLength;
+				ulBestDistance = ulPos - lCandidate;
+			}
+		}
+
+		if(ulBestLength < ASSET_LZ_MATCH_MIN) {
+			pPrevs[ulPos] = pHeads[ulHash];
+			pHeads[ulHash] = ulPos;
+			++ulPos;
+			continue;
+		}
+
+		lzWriteSequence(
+			&pOut, &pSrc[ulLiteralStart], ulPos - ulLiteralStart,
+			ulBestLength, ulBestDistance
+		);
+		for(ULONG ulEnd = ulPos + ulBestLength; ulPos < ulEnd; ++ulPos) {
+			if(ulPos + ASSET_LZ_MATCH_MIN <= ulSize) {
+				ulHash = lzHash(&pSrc[ulPos]);
+				pPrevs[ulPos] = pHeads[ulHash];
+				pHeads[ulHash] = ulPos;
+			}
+		}
+		ulLiteralStart = ulPos;
+	}
+	if(ulLiteralStart < ulSize) {
+		lzWriteSequence(
+			&pOut, &pSrc[ulLiteralStart], ulSize - ulLiteralStart, 0, 0
+		);
+	}
+
+	free(pHeads);
+	free(pPrevs);
+	*pPackedSize = pOut - pPacked;
+	return pPacked;
+}
+
+static ULONG memReaderRead(void *pData, UBYTE *pDest, ULONG ulSize) {
+	tMemReader *pReader = pData;
+	if(ulSize > pReader->ulLeft) {
+		ulSize = pReader->ulLeft;
+	}
+	if(ulSize > pReader->ulChunk) {
+		ulSize = pReader->ulChunk;
+	}
+	memcpy(pDest, pReader->pData, ulSize);
+	pReader->pData += ulSize;
+	pReader->ulLeft -= ulSize;
+	return ulSize;
+}
+
+// Decompresses with game's code, using uneven read sizes on both ends so
+// that resuming of the stream gets tested too.
+static UBYTE lzVerify(
+	const UBYTE *pPacked, ULONG ulPackedSize, const UBYTE *pOrig, ULONG ulSize
+) {
+	static const ULONG pReadSizes[] = {1, 7, 40, 333, 4096};
+	static tAssetLz s_sLz;
+	tMemReader sReader = {.pData = pPacked, .ulLeft = ulPackedSize, .ulChunk = 77};
+	UBYTE *pOut = malloc(ulSize + 1);
+	if(!pOut) {
+		return 0;
+	}
+	assetLzInit(&s_sLz, ulSize, memReaderRead, &sReader);
+	ULONG ulDone = 0;
+	for(UBYTE i = 0; ; i = (i + 1) % (sizeof(pReadSizes) / sizeof(pReadSizes[0]))) {
+		ULONG ulRead = assetLzRead(&s_sLz, &pOut[ulDone], pReadSizes[i]);
+		if(!ulRead) {
+			break;
+		}
+		ulDone += ulRead;
+	}
+	UBYTE isOk = (
+		ulDone == ulSize && !sReader.ulLeft && !memcmp(pOut, pOrig, ulSize)
+	);
+	free(pOut);
+	return isOk;
+}
+
+static UWORD readWordBe(const UBYTE *pData) {
+	return (pData[0] << 8) | pData[1];
+}
+
+// Replaces mask bitmap's data with its first plane, if all planes are same.
+static UBYTE maskSquash(tEntry *pEntry) {
+	const UBYTE *pSrc = pEntry->pData;
+	if(pEntry->ulSize < ASSET_PACK_BM_HEADER_SIZE) {
+		fprintf(stderr, "ERR: mask '%s' is not a bitmap\n", pEntry->szName);
+		return 0;
+	}
+	UWORD uwWidth = readWordBe(&pSrc[0]);
+	UWORD uwHeight = readWordBe(&pSrc[2]);
+	UBYTE ubBpp = pSrc[4];
+	UBYTE isInterleaved = (pSrc[6] & ASSET_PACK_BM_FLAG_INTERLEAVED) != 0;
+	ULONG ulRowSize = ((uwWidth + 15) / 16) * 2;
+	ULONG ulPlaneSize = ulRowSize * uwHeight;
+	if(!ubBpp || pEntry->ulSize != ASSET_PACK_BM_HEADER_SIZE + ulPlaneSize * ubBpp) {
+		fprintf(stderr, "ERR: mask '%s' has unexpected size\n", pEntry->szName);
+		return 0;
+	}
+
+	const UBYTE *pPlanes = &pSrc[ASSET_PACK_BM_HEADER_SIZE];
+	UBYTE *pSquashed = malloc(ASSET_PACK_BM_HEADER_SIZE + ulPlaneSize);
+	if(!pSquashed) {
+		fprintf(stderr, "ERR: out of memory squashing '%s'\n", pEntry->szName);
+		return 0;
+	}
+	memcpy(pSquashed, pSrc, ASSET_PACK_BM_HEADER_SIZE);
+	pSquashed[4] = 1;
+	pSquashed[6] &= ~ASSET_PACK_BM_FLAG_INTERLEAVED;
+	for(UWORD uwY = 0; uwY < uwHeight; ++uwY) {
+		const UBYTE *pRows[256];
+		for(UBYTE ubPlane = 0; ubPlane < ubBpp; ++ubPlane) {
+			pRows[ubPlane] = &pPlanes[
+				isInterleaved ?
+				(uwY * ubBpp + ubPlane) * ulRowSize :
+				ubPlane * ulPlaneSize + uwY * ulRowSize
+			];
+			if(memcmp(pRows[ubPlane], pRows[0], ulRowSize)) {
+				fprintf(
+					stderr, "ERR: mask '%s' differs on plane %u, row %u\n",
+					pEntry->szName, ubPlane, uwY
+				);
+				free(pSquashed);
+				return 0;
+			}
+		}
+		memcpy(
+			&pSquashed[ASSET_PACK_BM_HEADER_SIZE + uwY * ulRowSize],
+			pRows[0], ulRowSize
+		);
+	}
+
+	free(pEntry->pData);
+	pEntry->pData = pSquashed;
+	pEntry->ulSize = ASSET_PACK_BM_HEADER_SIZE + ulPlaneSize;
+	pEntry->ulPackedSize = pEntry->ulSize;
+	return 1;
+}
+
+static UBYTE hasExtension(const char *szName, const char *szExt) {
+	size_t lNameLength = strlen(szName);
+	size_t lExtLength = strlen(szExt);
+	return (
+		lExtLength && lNameLength > lExtLength &&
+		!strcmp(&szName[lNameLength - lExtLength], szExt)
+	);
+}
+
+static UBYTE parseEntry(
+	const char *szArg, const char *szBaseDir, const char *szLzExt, tEntry *pEntry
+) {
+	const char *szName;
+	UBYTE isMask = 0;
+	if(!strncmp(szArg, "CHIP:", 5)) {
+		pEntry->ubMemType = ASSET_PACK_MEM_CHIP;
+		szName = &szArg[5];
+	}
+	else if(!strncmp(szArg, "MASK:", 5)) {
+		pEntry->ubMemType = ASSET_PACK_MEM_CHIP;
+		szName = &szArg[5];
+		isMask = 1;
+	}
+	else if(!strncmp(szArg, "FAST:", 5)) {
+		pEntry->ubMemType = ASSET_PACK_MEM_FAST;
+		szName = &szArg[5];
+	}
+	else {
+		fprintf(stderr, "ERR: '%s' lacks CHIP:, FAST: or MASK: prefix\n", szArg);
+		return 0;
+	}
+	if(!*szName || strlen(szName) >= ASSET_PACK_NAME_SIZE) {
+		fprintf(stderr, "ERR: name '%s' is empty or too long\n", szName);
+		return 0;
+	}
+	pEntry->szName = szName;
+
+	char szPath[1024];
+	snprintf(szPath, sizeof(szPath), "%s/%s", szBaseDir, szName);
+	pEntry->pData = readFile(szPath, &pEntry->ulSize);
+	if(!pEntry->pData) {
+		fprintf(stderr, "ERR: can't read '%s'\n", szPath);
+		return 0;
+	}
+	pEntry->ulPackedSize = pEntry->ulSize;
+	pEntry->ubFlags = 0;
+	if(isMask && !maskSquash(pEntry)) {
+		free(pEntry->pData);
+		return 0;
+	}
+	if(!hasExtension(szName, szLzExt)) {
+		return 1;
+	}
+
+	ULONG ulPackedSize;
+	UBYTE *pPacked = lzCompress(pEntry->pData, pEntry->ulSize, &ulPackedSize);
+	if(!pPacked) {
+		fprintf(stderr, "ERR: out of memory compressing '%s'\n", szName);
+		free(pEntry->pData);
+		return 0;
+	}
+	if(!lzVerify(pPacked, ulPackedSize, pEntry->pData, pEntry->ulSize)) {
+		fprintf(stderr, "ERR: '%s' doesn't decompress to original\n", szName);
+		free(pPacked);
+		free(pEntry->pData);
+		return 0;
+	}
+	if(ulPackedSize >= pEntry->ulSize) {
+		free(pPacked);
+		return 1;
+	}
+	free(pEntry->pData);
+	pEntry->pData = pPacked;
+	pEntry->ulPackedSize = ulPackedSize;
+	pEntry->ubFlags = ASSET_PACK_FLAG_LZ;
+	return 1;
+}
+
+static void writeWordBe(FILE *pOut, UWORD uwValue) {
+	fputc(uwValue >> 8, pOut);
+	fputc(uwValue & 0xFF, pOut);
+}
+
+static void writeLongBe(FILE *pOut, ULONG ulValue) {
+	writeWordBe(pOut, ulValue >> 16);
+	writeWordBe(pOut, ulValue & 0xFFFF);
+}
+
+int main(int lArgCount, char *pArgs[]) {
+	const char *szLzExt = "";
+	int lArg = 1;
+	if(lArg + 1 < lArgCount && !strcmp(pArgs[lArg], "-lz")) {
+		szLzExt = pArgs[lArg + 1];
+		lArg += 2;
+	}
+	UWORD uwEntryCount = lArgCount - lArg - 2;
+	if(lArgCount - lArg < 3 || uwEntryCount > ASSET_PACK_ENTRIES_MAX) {
+		fprintf(
+			stderr, "Usage: %s [-lz .ext] out.pak base_dir CHIP|FAST|MASK:name...\n"
+			"Up to %d files, names shorter than %d chars\n",
+			pArgs[0], ASSET_PACK_ENTRIES_MAX, ASSET_PACK_NAME_SIZE
+		);
+		return EXIT_FAILURE;
+	}
+	const char *szOutPath = pArgs[lArg];
+	const char *szBaseDir = pArgs[lArg + 1];
+	lArg += 2;
+
+	static tEntry s_pEntries[ASSET_PACK_ENTRIES_MAX];
+	UBYTE isOk = 1;
+	UWORD uwRead = 0;
+	ULONG ulOffset = ASSET_PACK_HEADER_SIZE + uwEntryCount * ASSET_PACK_ENTRY_SIZE;
+	ULONG ulTotalSize = 0;
+	for(; isOk && uwRead < uwEntryCount; ++uwRead) {
+		tEntry *pEntry = &s_pEntries[uwRead];
+		isOk = parseEntry(pArgs[lArg + uwRead], szBaseDir, szLzExt, pEntry);
+		for(UWORD i = 0; isOk && i < uwRead; ++i) {
+			if(!strcmp(s_pEntries[i].szName, pEntry->szName)) {
+				fprintf(stderr, "ERR: '%s' given twice\n", pEntry->szName);
+				free(pEntry->pData);
+				isOk = 0;
+			}
+		}
+		pEntry->ulOffset = ulOffset;
+		ulOffset += pEntry->ulPackedSize;
+		ulTotalSize += pEntry->ulSize;
+	}
+	if(!isOk) {
+		--uwRead;
+	}
+
+	if(isOk) {
+		FILE *pOut = fopen(szOutPath, "wb");
+		if(!pOut) {
+			fprintf(stderr, "ERR: can't write '%s'\n", szOutPath);
+			isOk = 0;
+		}
+		else {
+			fputc(ASSET_PACK_VERSION, pOut);
+			fputc(0, pOut);
+			writeWordBe(pOut, uwEntryCount);
+			for(UWORD i = 0; i < uwEntryCount; ++i) {
+				char szName[ASSET_PACK_NAME_SIZE] = {0};
+				strcpy(szName, s_pEntries[i].szName);
+				fwrite(szName, 1, sizeof(szName), pOut);
+				fputc(s_pEntries[i].ubMemType, pOut);
+				fputc(s_pEntries[i].ubFlags, pOut);
+				writeLongBe(pOut, s_pEntries[i].ulOffset);
+				writeLongBe(pOut, s_pEntries[i].ulSize);
+				writeLongBe(pOut, s_pEntries[i].ulPackedSize);
+			}
+			for(UWORD i = 0; i < uwEntryCount; ++i) {
+				fwrite(s_pEntries[i].pData, 1, s_pEntries[i].ulPackedSize, pOut);
+			}
+			isOk = !ferror(pOut);
+			fclose(pOut);
+		}
+	}
+
+	if(isOk) {
+		printf(
+			"Packed %u files, %lu bytes into %lu\n", uwEntryCount,
+			(unsigned long)ulTotalSize, (unsigned long)ulOffset
+		);
+	}
+	for(UWORD i = 0; i < uwRead; ++i) {
+		free(s_pEntries[i].pData);
+	}
+	return isOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "mixer_ref.h"
+#include <string.h>
+
+#define MIXER_REF_PAL_CYCLES 3546895
+#define MIXER_REF_PERIOD_MIN 124
+#define MIXER_REF_FX_ONCE 1
+#define MIXER_REF_FX_LOOP -1
+
+// Mixer's empty buffer - one-shots keep reading it after they end.
+static const BYTE s_pEmpty[MIXER_REF_BUFFER_SIZE_MAX];
+
+//------------------------------------------------------------------ PRIVATE FNS
+
+static ULONG mixerRefReadLong(const BYTE *pSrc) {
+	const UBYTE *pBytes = (const UBYTE*)pSrc;
+	return (
+		((ULONG)pBytes[0] << 24) | ((ULONG)pBytes[1] << 16) |
+		((ULONG)pBytes[2] << 8) | pBytes[3]
+	);
+}
+
+static void mixerRefWriteLong(BYTE *pDst, ULONG ulValue) {
+	UBYTE *pBytes = (UBYTE*)pDst;
+	pBytes[0] = ulValue >> 24;
+	pBytes[1] = ulValue >> 16;
+	pBytes[2] = ulValue >> 8;
+	pBytes[3] = ulValue;
+}
+
+// Same as add.l of all channels' longwords, so carry of a byte goes into
+// the preceding one.
+static void mixerRefMix(
+	BYTE *pDst, const BYTE **pSrcs, UBYTE ubSrcCount, ULONG ulSize
+) {
+	for(ULONG ulPos = 0; ulPos < ulSize; ulPos += 4) {
+		ULONG ulSum = 0;
+		for(UBYTE i = 0; i < ubSrcCount; ++i) {
+			ulSum += mixerRefReadLong(&pSrcs[i][ulPos]);
+		}
+		mixerRefWriteLong(&pDst[ulPos], ulSum);
+	}
+	for(UBYTE i = 0; i < ubSrcCount; ++i) {
+		pSrcs[i] += ulSize;
+	}
+}
+
+// Word-sized builds compare lengths as unsigned words, long ones as signed
+// longwords.
+static UBYTE mixerRefIsLonger(
+	const tMixerRef *pMixer, ULONG ulLength, ULONG ulOther
+) {
+	if(pMixer->sConfig.isWordSized) {
+		return (UWORD)ulLength > (UWORD)ulOther;
+	}
+	return (LONG)ulLength > (LONG)ulOther;
+}
+
+static ULONG mixerRefMaskLength(const tMixerRef *pMixer, ULONG ulLength) {
+	if(pMixer->sConfig.isWordSized) {
+		ulLength &= 0xFFFF;
+	}
+	return ulLength & (pMixer->sConfig.isSizeX32 ? ~31u : ~3u);
+}
+
+//------------------------------------------------------------------- PUBLIC FNS
+
+UWORD mixerRefGetBufferSize(const tMixerRefConfig *pConfig) {
+	ULONG ulSamples = MIXER_REF_PAL_CYCLES / pConfig->uwPeriod / 50;
+	if(!pConfig->is68020 && pConfig->isSizeX32) {
+		return (ulSamples & 65504) + 32;
+	}
+	return (ulSamples & 65532) + 4;
+}
+
+UBYTE mixerRefInit(tMixerRef *pMixer, const tMixerRefConfig *pConfig) {
+	if(
+		pConfig->uwPeriod < MIXER_REF_PERIOD_MIN ||
+		!pConfig->ubChannelCount ||
+		pConfig->ubChannelCount > MIXER_REF_CHANNELS_MAX
+	) {
+		return 0;
+	}
+	memset(pMixer, 0, sizeof(*pMixer));
+	pMixer->sConfig = *pConfig;
+	pMixer->uwBufferSize = mixerRefGetBufferSize(pConfig);
+	return 1;
+}
+
+UBYTE mixerRefPlay(
+	tMixerRef *pMixer, UBYTE ubChannel, const BYTE *pData, ULONG ulLength,
+	WORD wPriority, UBYTE isLoop
+) {
+	tMixerRefChannel *pChannel = &pMixer->pChannels[ubChannel];
+	if(
+		pChannel->wStatus < 0 ||
+		(pChannel->wStatus > 0 && wPriority < pChannel->wPriority)
+	) {
+		return 0;
+	}
+
+	ulLength = mixerRefMaskLength(pMixer, ulLength);
+	pChannel->pSample = pData;
+	pChannel->pOrigSample = pData;
+	pChannel->pLoop = isLoop ? pData : s_pEmpty;
+	pChannel->ulRemaining = ulLength;
+	pChannel->ulLoopLength = ulLength;
+	pChannel->wPriority = wPriority;
+	pChannel->wStatus = isLoop ? MIXER_REF_FX_LOOP : MIXER_REF_FX_ONCE;
+	return 1;
+}
+
+void mixerRefStop(tMixerRef *pMixer, UBYTE ubChannel) {
+	pMixer->pChannels[ubChannel].wStatus = 0;
+}
+
+UBYTE mixerRefIsPlaybackDone(const tMixerRef *pMixer, UBYTE ubChannel) {
+	return pMixer->pChannels[ubChannel].wStatus == 0;
+}
+
+void mixerRefSetSfxEndCallback(
+	tMixerRef *pMixer, tMixerRefCbSfxEnd cbSfxEnd, void *pUserData
+) {
+	pMixer->cbSfxEnd = cbSfxEnd;
+	pMixer->pCbUserData = pUserData;
+}
+
+const BYTE *mixerRefRun(tMixerRef *pMixer) {
+	BYTE *pOut = pMixer->pBuffers[pMixer->ubBuffer];
+	pMixer->ubBuffer ^= 1;
+
+	// Channels active at interrupt start are mixed until its end, even if
+	// they get stopped or started by the callback meanwhile.
+	UBYTE pActive[MIXER_REF_CHANNELS_MAX];
+	const BYTE *pPtrs[MIXER_REF_CHANNELS_MAX];
+	UBYTE ubActiveCount = 0;
+	ULONG ulSegment = pMixer->uwBufferSize;
+	for(UBYTE ubChannel = 0; ubChannel < pMixer->sConfig.ubChannelCount; ++ubChannel) {
+		const tMixerRefChannel *pChannel = &pMixer->pChannels[ubChannel];
+		if(!pChannel->wStatus) {
+			continue;
+		}
+		pActive[ubActiveCount] = ubChannel;
+		pPtrs[ubActiveCount] = pChannel->pSample;
+		++ubActiveCount;
+		if(mixerRefIsLonger(pMixer, ulSegment, pChannel->ulRemaining)) {
+			ulSegment = pChannel->ulRemaining;
+		}
+	}
+	if(!ubActiveCount) {
+		return s_pEmpty;
+	}
+
+	// Mix in segments up to the nearest sample end. Buffer's tail is left
+	// as it was if any channel got stuck at zero length.
+	ULONG ulPos = 0;
+	ULONG ulLeft = pMixer->uwBufferSize;
+	do {
+		mixerRefMix(&pOut[ulPos], pPtrs, ubActiveCount, ulSegment);
+		ulPos += ulSegment;
+		ulLeft -= ulSegment;
+
+		ULONG ulNextSegment = ulLeft;
+		for(UBYTE i = 0; i < ubActiveCount; ++i) {
+			UBYTE ubChannel = pActive[i];
+			tMixerRefChannel *pChannel = &pMixer->pChannels[ubChannel];
+			ULONG ulRemaining;
+			if(mixerRefIsLonger(pMixer, pChannel->ulRemaining, ulSegment)) {
+				ulRemaining = pChannel->ulRemaining - ulSegment;
+			}
+			else {
+				// Only low byte is cleared, so loops stay negative
+				pChannel->wStatus = (WORD)(pChannel->wStatus & 0xFF00);
+				ulRemaining = pChannel->ulLoopLength;
+				pPtrs[i] = pChannel->pLoop;
+				if(pChannel->wStatus >= 0 && pMixer->cbSfxEnd) {
+					if(pMixer->cbSfxEnd(
+						pMixer, ubChannel, pChannel->pOrigSample, pMixer->pCbUserData
+					)) {
+						ulRemaining = pChannel->ulRemaining;
+						pPtrs[i] = pChannel->pSample;
+					}
+				}
+			}
+			pChannel->ulRemaining = ulRemaining;
+			pChannel->pSample = pPtrs[i];
+			if(mixerRefIsLonger(pMixer, ulNextSegment, ulRemaining)) {
+				ulNextSegment = ulRemaining;
+			}
+		}
+		ulSegment = ulNextSegment;
+	} while(ulSegment);
+
+	return pOut;
+}
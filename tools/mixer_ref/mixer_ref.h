@@ -0,0 +1,123 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef SURVIVOR_MIXER_REF_H
+#define SURVIVOR_MIXER_REF_H
+
+// Portable reference of deps/ace_audio_mixer's software mix, as configured
+// for the game: single hardware channel, no HQ mode, no plugins. Follows
+// mixer.asm's code step by step, including its quirks: channels are summed
+// as big-endian longwords, so carries cross into the neighbouring samples,
+// and a sample ending mid-buffer keeps being mixed from the empty buffer
+// until the buffer is done. Not yet compared against mixer.asm's output
+// captured in emulator, so it's a model of it rather than a verified twin.
+
+#include <stdint.h>
+
+// ACE types
+typedef uint8_t UBYTE;
+typedef int8_t BYTE;
+typedef uint16_t UWORD;
+typedef int16_t WORD;
+typedef uint32_t ULONG;
+typedef int32_t LONG;
+
+#define MIXER_REF_CHANNELS_MAX 4
+// Buffer size for the lowest period supported by the mixer, 124.
+#define MIXER_REF_BUFFER_SIZE_MAX 608
+
+/**
+ * @brief Mixer build settings, same as AUDIO_MIXER_* CMake ones.
+ */
+typedef struct tMixerRefConfig {
+	UWORD uwPeriod; ///< PAL playback period.
+	UBYTE ubChannelCount; ///< Software channel count, 1-4.
+	UBYTE is68020; ///< 68020 code, which only rounds buffer to 4 bytes.
+	UBYTE isSizeX32; ///< Sample lengths rounded to 32 bytes.
+	UBYTE isWordSized; ///< Sample lengths kept in words.
+} tMixerRefConfig;
+
+typedef struct tMixerRef tMixerRef;
+
+/**
+ * @brief Callback for end of one-shot sample, as in audio_mixer.h.
+ *
+ * @param pMixer Mixer which is in the middle of mixing its buffer.
+ * @param ubChannel Software channel on which playback has ended.
+ * @param pData Data of sample which has ended.
+ * @param pUserData Pointer passed to mixerRefSetSfxEndCallback().
+ * @return 1 if callback started next sample on the same channel, otherwise 0.
+ */
+typedef UBYTE (*tMixerRefCbSfxEnd)(
+	tMixerRef *pMixer, UBYTE ubChannel, const BYTE *pData, void *pUserData
+);
+
+typedef struct tMixerRefChannel {
+	const BYTE *pSample; ///< Next byte to be mixed.
+	const BYTE *pOrigSample; ///< Sample start, passed to the callback.
+	const BYTE *pLoop; ///< Restart position, empty buffer for one-shots.
+	ULONG ulRemaining; ///< Bytes left until pLoop is used.
+	ULONG ulLoopLength;
+	WORD wStatus; ///< 0 if free, 1 for one-shot, negative for loop.
+	WORD wPriority;
+} tMixerRefChannel;
+
+struct tMixerRef {
+	tMixerRefConfig sConfig;
+	UWORD uwBufferSize;
+	UBYTE ubBuffer; ///< Buffer to be mixed by next interrupt.
+	tMixerRefCbSfxEnd cbSfxEnd;
+	void *pCbUserData;
+	tMixerRefChannel pChannels[MIXER_REF_CHANNELS_MAX];
+	BYTE pBuffers[2][MIXER_REF_BUFFER_SIZE_MAX];
+};
+
+/**
+ * @brief Returns bytes mixed by single mixer interrupt, as set up by
+ * mixer.i for PAL.
+ */
+UWORD mixerRefGetBufferSize(const tMixerRefConfig *pConfig);
+
+/**
+ * @brief Sets up mixer with all channels free & buffers cleared, as after
+ * MixerSetup().
+ *
+ * @return 1 on success, 0 if config is out of mixer's range.
+ */
+UBYTE mixerRefInit(tMixerRef *pMixer, const tMixerRefConfig *pConfig);
+
+/**
+ * @brief Equivalent of MixerPlayChannelSample() with MIX_FX_ONCE or
+ * MIX_FX_LOOP. Can be called from within the sample end callback.
+ * Length is rounded down to the mixer's sample size multiple.
+ *
+ * @return 1 if sample got started, 0 if channel is busy with sample of
+ * higher priority or a loop.
+ */
+UBYTE mixerRefPlay(
+	tMixerRef *pMixer, UBYTE ubChannel, const BYTE *pData, ULONG ulLength,
+	WORD wPriority, UBYTE isLoop
+);
+
+void mixerRefStop(tMixerRef *pMixer, UBYTE ubChannel);
+
+UBYTE mixerRefIsPlaybackDone(const tMixerRef *pMixer, UBYTE ubChannel);
+
+/**
+ * @brief Sets callback for one-shot sample end, zero to disable it.
+ */
+void mixerRefSetSfxEndCallback(
+	tMixerRef *pMixer, tMixerRefCbSfxEnd cbSfxEnd, void *pUserData
+);
+
+/**
+ * @brief Does the work of a single mixer interrupt.
+ *
+ * @return Buffer of mixerRefGetBufferSize() bytes which is played as result,
+ * i.e. either the freshly mixed one or the empty buffer if no channel was
+ * active. Valid until next call.
+ */
+const BYTE *mixerRefRun(tMixerRef *pMixer);
+
+#endif // SURVIVOR_MIXER_REF_H
@@ -0,0 +1,263 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Host-side renderer of mixer output, using the reference mixer. Plays
+// samples as told by the script and writes all buffers played by Paula,
+// one per mixer interrupt. If expected output is given - earlier output of
+// this tool, or capture of the same script run through mixer.asm, dumped
+// from emulator at each mixer interrupt starting with the first one after
+// MixerStart() - reports first mismatch.
+// Build: cc -std=c11 -O2 -o mixer_ref mixer_ref.c mixer_ref_main.c
+// Usage: mixer_ref script.txt output.raw [expected.raw]
+//
+// Script lines, settings default to the game's ones:
+//   period <period>
+//   channels <software channel count>
+//   cpu 68000|68020
+//   round32 0|1
+//   wordsized 0|1
+//   sample <name> <path to raw signed 8-bit data>
+//   at <interrupt> play <channel> <sample> <priority> once|loop
+//   at <interrupt> stop <channel>
+//   at <interrupt> chain <channel> <sample> <priority>
+//   run <interrupt count>
+// Events must be in order of interrupts, they're done right before given
+// interrupt. Chain queues one-shot to be started by sample end callback of
+// given channel, same as sfx_sequence does.
+
+#include "mixer_ref.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLES_MAX 32
+#define NAME_LENGTH_MAX 32
+#define LINE_LENGTH_MAX 256
+
+typedef struct tSample {
+	char szName[NAME_LENGTH_MAX];
+	BYTE *pData;
+	ULONG ulLength;
+} tSample;
+
+typedef struct tChain {
+	const tSample *pSample;
+	WORD wPriority;
+} tChain;
+
+static tSample s_pSamples[SAMPLES_MAX];
+static UBYTE s_ubSampleCount;
+static tChain s_pChains[MIXER_REF_CHANNELS_MAX];
+
+static const tSample *findSample(const char *szName) {
+	for(UBYTE i = 0; i < s_ubSampleCount; ++i) {
+		if(!strcmp(s_pSamples[i].szName, szName)) {
+			return &s_pSamples[i];
+		}
+	}
+	fprintf(stderr, "ERR: unknown sample '%s'\n", szName);
+	return 0;
+}
+
+static UBYTE loadSample(const char *szName, const char *szPath) {
+	if(s_ubSampleCount == SAMPLES_MAX) {
+		fprintf(stderr, "ERR: too many samples\n");
+		return 0;
+	}
+	FILE *pFile = fopen(szPath, "rb");
+	if(!pFile) {
+		fprintf(stderr, "ERR: can't open '%s'\n", szPath);
+		return 0;
+	}
+	fseek(pFile, 0, SEEK_END);
+	long lSize = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+	tSample *pSample = &s_pSamples[s_ubSampleCount];
+	pSample->pData = malloc(lSize ? lSize : 1);
+	UBYTE isOk = pSample->pData && fread(pSample->pData, 1, lSize, pFile) == (size_t)lSize;
+	fclose(pFile);
+	if(!isOk) {
+		fprintf(stderr, "ERR: can't read '%s'\n", szPath);
+		free(pSample->pData);
+		return 0;
+	}
+	snprintf(pSample->szName, sizeof(pSample->szName), "%s", szName);
+	pSample->ulLength = lSize;
+	++s_ubSampleCount;
+	return 1;
+}
+
+static UBYTE onSfxEnd(
+	tMixerRef *pMixer, UBYTE ubChannel, __attribute__((unused)) const BYTE *pData,
+	__attribute__((unused)) void *pUserData
+) {
+	tChain *pChain = &s_pChains[ubChannel];
+	if(!pChain->pSample) {
+		return 0;
+	}
+	const tSample *pSample = pChain->pSample;
+	pChain->pSample = 0;
+	return mixerRefPlay(
+		pMixer, ubChannel, pSample->pData, pSample->ulLength, pChain->wPriority, 0
+	);
+}
+
+static UBYTE compareCapture(
+	FILE *pCapture, const BYTE *pBuffer, UWORD uwSize, ULONG ulInterrupt
+) {
+	BYTE pCaptured[MIXER_REF_BUFFER_SIZE_MAX];
+	if(fread(pCaptured, 1, uwSize, pCapture) != uwSize) {
+		fprintf(stderr, "ERR: expected output ends before interrupt %lu\n", (unsigned long)ulInterrupt);
+		return 0;
+	}
+	for(UWORD uwPos = 0; uwPos < uwSize; ++uwPos) {
+		if(pCaptured[uwPos] != pBuffer[uwPos]) {
+			fprintf(
+				stderr, "ERR: interrupt %lu, byte %u: rendered %d, expected %d\n",
+				(unsigned long)ulInterrupt, uwPos, pBuffer[uwPos], pCaptured[uwPos]
+			);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int main(int lArgCount, char *pArgs[]) {
+	if(lArgCount != 3 && lArgCount != 4) {
+		fprintf(stderr, "Usage: %s script.txt output.raw [expected.raw]\n", pArgs[0]);
+		return EXIT_FAILURE;
+	}
+
+	FILE *pScript = fopen(pArgs[1], "r");
+	FILE *pOut = fopen(pArgs[2], "wb");
+	FILE *pCapture = lArgCount == 4 ? fopen(pArgs[3], "rb") : 0;
+	if(!pScript || !pOut || (lArgCount == 4 && !pCapture)) {
+		fprintf(stderr, "ERR: can't open input or output files\n");
+		return EXIT_FAILURE;
+	}
+
+	tMixerRefConfig sConfig = {
+		.uwPeriod = 161, .ubChannelCount = 3, .is68020 = 0,
+		.isSizeX32 = 1, .isWordSized = 1
+	};
+	static tMixerRef s_sMixer;
+	UBYTE isStarted = 0;
+	UBYTE isOk = 1;
+	ULONG ulInterrupt = 0;
+	ULONG ulLine = 0;
+	char szLine[LINE_LENGTH_MAX];
+	while(isOk && fgets(szLine, sizeof(szLine), pScript)) {
+		++ulLine;
+		char szCmd[NAME_LENGTH_MAX], szArg[NAME_LENGTH_MAX], szPath[LINE_LENGTH_MAX];
+		unsigned long ulValue, ulChannel;
+		int lPriority;
+		if(sscanf(szLine, " %31s", szCmd) != 1 || szCmd[0] == '#') {
+			continue;
+		}
+
+		if(!isStarted && strcmp(szCmd, "at") && strcmp(szCmd, "run")) {
+			if(!strcmp(szCmd, "sample") && sscanf(szLine, " %*s %31s %255s", szArg, szPath) == 2) {
+				isOk = loadSample(szArg, szPath);
+				continue;
+			}
+			if(sscanf(szLine, " %*s %31s", szArg) != 1) {
+				isOk = 0;
+			}
+			else if(!strcmp(szCmd, "period")) {
+				sConfig.uwPeriod = strtoul(szArg, 0, 10);
+			}
+			else if(!strcmp(szCmd, "channels")) {
+				sConfig.ubChannelCount = strtoul(szArg, 0, 10);
+			}
+			else if(!strcmp(szCmd, "cpu")) {
+				sConfig.is68020 = !strcmp(szArg, "68020");
+			}
+			else if(!strcmp(szCmd, "round32")) {
+				sConfig.isSizeX32 = strtoul(szArg, 0, 10);
+			}
+			else if(!strcmp(szCmd, "wordsized")) {
+				sConfig.isWordSized = strtoul(szArg, 0, 10);
+			}
+			else {
+				isOk = 0;
+			}
+			if(!isOk) {
+				fprintf(stderr, "ERR: bad setting in line %lu\n", (unsigned long)ulLine);
+			}
+			continue;
+		}
+
+		if(!isStarted) {
+			if(!mixerRefInit(&s_sMixer, &sConfig)) {
+				fprintf(stderr, "ERR: unsupported mixer settings\n");
+				isOk = 0;
+				break;
+			}
+			mixerRefSetSfxEndCallback(&s_sMixer, onSfxEnd, 0);
+			isStarted = 1;
+		}
+
+		if(!strcmp(szCmd, "run")) {
+			ulValue = 0;
+			sscanf(szLine, " %*s %lu", &ulValue);
+		}
+		else if(
+			sscanf(szLine, " at %lu %31s %lu", &ulValue, szCmd, &ulChannel) != 3 ||
+			ulChannel >= sConfig.ubChannelCount || ulValue < ulInterrupt
+		) {
+			fprintf(stderr, "ERR: bad event in line %lu\n", (unsigned long)ulLine);
+			isOk = 0;
+			break;
+		}
+
+		// Mix up to given interrupt
+		for(; isOk && ulInterrupt < ulValue; ++ulInterrupt) {
+			const BYTE *pBuffer = mixerRefRun(&s_sMixer);
+			fwrite(pBuffer, 1, s_sMixer.uwBufferSize, pOut);
+			if(pCapture) {
+				isOk = compareCapture(pCapture, pBuffer, s_sMixer.uwBufferSize, ulInterrupt);
+			}
+		}
+
+		if(!strcmp(szCmd, "stop")) {
+			mixerRefStop(&s_sMixer, ulChannel);
+		}
+		else if(!strcmp(szCmd, "play") || !strcmp(szCmd, "chain")) {
+			const tSample *pSample;
+			char szMode[NAME_LENGTH_MAX] = "once";
+			if(sscanf(
+				szLine, " at %*u %*s %*u %31s %d %31s", szArg, &lPriority, szMode
+			) < 2 || !(pSample = findSample(szArg))) {
+				fprintf(stderr, "ERR: bad event in line %lu\n", (unsigned long)ulLine);
+				isOk = 0;
+			}
+			else if(!strcmp(szCmd, "chain")) {
+				s_pChains[ulChannel] = (tChain){.pSample = pSample, .wPriority = lPriority};
+			}
+			else {
+				mixerRefPlay(
+					&s_sMixer, ulChannel, pSample->pData, pSample->ulLength,
+					lPriority, !strcmp(szMode, "loop")
+				);
+			}
+		}
+		else if(strcmp(szCmd, "run")) {
+			fprintf(stderr, "ERR: unknown event in line %lu\n", (unsigned long)ulLine);
+			isOk = 0;
+		}
+	}
+
+	if(isOk && pCapture) {
+		printf("Output matches expected one for %lu interrupts\n", (unsigned long)ulInterrupt);
+	}
+	fclose(pScript);
+	fclose(pOut);
+	if(pCapture) {
+		fclose(pCapture);
+	}
+	for(UBYTE i = 0; i < s_ubSampleCount; ++i) {
+		free(s_pSamples[i].pData);
+	}
+	return isOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,273 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Host-side converter of WAV files into sound bank read by src/sfx_bank.c.
+// Samples are stored as signed 8-bit data, ready to be played by the mixer:
+// optionally normalized & divided for mixing, padded to mixer's sample size
+// multiple. Sample rate is not converted, only checked against mixer's one.
+// Usage: sfx_bank [-normalize] [-divide n] [-pad n] [-rate hz] out.bank in.wav...
+//
+// Bank layout, big-endian:
+//   UBYTE ubVersion, UBYTE ubSfxCount, UBYTE ubDivide
+//   UWORD pWordLengths[ubSfxCount]
+//   sample data, one after another
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t UBYTE;
+typedef int8_t BYTE;
+typedef uint16_t UWORD;
+typedef int16_t WORD;
+typedef uint32_t ULONG;
+typedef int32_t LONG;
+
+#define SFX_BANK_VERSION 2
+#define SFX_BANK_SFX_MAX 255
+// Mixer is built with word-sized sample lengths.
+#define SFX_BANK_LENGTH_MAX 65535
+// Allowed mismatch between WAV & mixer sample rates, in percent.
+#define SFX_BANK_RATE_TOLERANCE 2
+
+typedef struct tSfx {
+	BYTE *pData;
+	ULONG ulLength; ///< Padded length, in bytes.
+} tSfx;
+
+typedef struct tOptions {
+	UBYTE isNormalize;
+	UBYTE ubDivide;
+	UWORD uwPad;
+	ULONG ulRate;
+} tOptions;
+
+static UWORD readWordLe(const UBYTE *pData) {
+	return pData[0] | (pData[1] << 8);
+}
+
+static ULONG readLongLe(const UBYTE *pData) {
+	return readWordLe(pData) | ((ULONG)readWordLe(&pData[2]) << 16);
+}
+
+static UBYTE *readFile(const char *szPath, ULONG *pSize) {
+	FILE *pFile = fopen(szPath, "rb");
+	if(!pFile) {
+		return 0;
+	}
+	fseek(pFile, 0, SEEK_END);
+	long lSize = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+	UBYTE *pData = malloc(lSize ? lSize : 1);
+	if(pData && fread(pData, 1, lSize, pFile) != (size_t)lSize) {
+		free(pData);
+		pData = 0;
+	}
+	fclose(pFile);
+	*pSize = lSize;
+	return pData;
+}
+
+// Reads PCM WAV as 16-bit range samples, stereo gets averaged.
+static LONG *readWav(
+	const char *szPath, ULONG *pSampleCount, ULONG *pRate
+) {
+	ULONG ulFileSize;
+	UBYTE *pFile = readFile(szPath, &ulFileSize);
+	if(!pFile) {
+		fprintf(stderr, "ERR: can't read '%s'\n", szPath);
+		return 0;
+	}
+	if(
+		ulFileSize < 12 || memcmp(pFile, "RIFF", 4) || memcmp(&pFile[8], "WAVE", 4)
+	) {
+		fprintf(stderr, "ERR: '%s' is not a WAV file\n", szPath);
+		free(pFile);
+		return 0;
+	}
+
+	UWORD uwFormat = 0, uwChannels = 0, uwBits = 0;
+	const UBYTE *pPcm = 0;
+	ULONG ulPcmSize = 0;
+	for(ULONG ulPos = 12; ulPos + 8 <= ulFileSize;) {
+		ULONG ulChunkSize = readLongLe(&pFile[ulPos + 4]);
+		const UBYTE *pChunk = &pFile[ulPos + 8];
+		if(ulChunkSize > ulFileSize - ulPos - 8) {
+			ulChunkSize = ulFileSize - ulPos - 8;
+		}
+		if(!memcmp(&pFile[ulPos], "fmt ", 4) && ulChunkSize >= 16) {
+			uwFormat = readWordLe(&pChunk[0]);
+			uwChannels = readWordLe(&pChunk[2]);
+			*pRate = readLongLe(&pChunk[4]);
+			uwBits = readWordLe(&pChunk[14]);
+		}
+		else if(!memcmp(&pFile[ulPos], "data", 4)) {
+			pPcm = pChunk;
+			ulPcmSize = ulChunkSize;
+		}
+		ulPos += 8 + ulChunkSize + (ulChunkSize & 1);
+	}
+	if(
+		uwFormat != 1 || !pPcm || (uwChannels != 1 && uwChannels != 2) ||
+		(uwBits != 8 && uwBits != 16)
+	) {
+		fprintf(stderr, "ERR: '%s' is not 8/16-bit mono/stereo PCM\n", szPath);
+		free(pFile);
+		return 0;
+	}
+
+	UBYTE ubFrameSize = uwChannels * (uwBits / 8);
+	ULONG ulCount = ulPcmSize / ubFrameSize;
+	LONG *pSamples = malloc((ulCount ? ulCount : 1) * sizeof(LONG));
+	for(ULONG i = 0; pSamples && i < ulCount; ++i) {
+		LONG lSum = 0;
+		for(UWORD uwChannel = 0; uwChannel < uwChannels; ++uwChannel) {
+			const UBYTE *pSample = &pPcm[i * ubFrameSize + uwChannel * (uwBits / 8)];
+			if(uwBits == 8) {
+				lSum += (pSample[0] - 128) * 256;
+			}
+			else {
+				lSum += (WORD)readWordLe(pSample);
+			}
+		}
+		pSamples[i] = lSum / uwChannels;
+	}
+	free(pFile);
+	*pSampleCount = ulCount;
+	return pSamples;
+}
+
+static UBYTE convertSfx(const char *szPath, const tOptions *pOptions, tSfx *pSfx) {
+	ULONG ulCount, ulRate = 0;
+	LONG *pSamples = readWav(szPath, &ulCount, &ulRate);
+	if(!pSamples) {
+		return 0;
+	}
+	if(
+		pOptions->ulRate &&
+		(ulRate * 100 < pOptions->ulRate * (100 - SFX_BANK_RATE_TOLERANCE) ||
+		ulRate * 100 > pOptions->ulRate * (100 + SFX_BANK_RATE_TOLERANCE))
+	) {
+		fprintf(
+			stderr, "WARN: '%s' has rate %lu Hz, mixer plays at %lu Hz\n",
+			szPath, (unsigned long)ulRate, (unsigned long)pOptions->ulRate
+		);
+	}
+
+	LONG lPeak = 1;
+	for(ULONG i = 0; i < ulCount; ++i) {
+		LONG lAbs = pSamples[i] < 0 ? -pSamples[i] : pSamples[i];
+		if(lAbs > lPeak) {
+			lPeak = lAbs;
+		}
+	}
+	LONG lTarget = pOptions->isNormalize ? 32767 : lPeak;
+
+	ULONG ulPadded = (
+		(ulCount + pOptions->uwPad - 1) / pOptions->uwPad
+	) * pOptions->uwPad;
+	if(ulPadded > SFX_BANK_LENGTH_MAX) {
+		fprintf(stderr, "ERR: '%s' is too long: %lu bytes\n", szPath, (unsigned long)ulPadded);
+		free(pSamples);
+		return 0;
+	}
+
+	pSfx->pData = calloc(ulPadded ? ulPadded : 1, 1);
+	pSfx->ulLength = ulPadded;
+	// Rounding may push the peak over 8-bit range's share of single channel,
+	// so clamp to it - otherwise ubDivide samples at peak overflow the mix.
+	LONG lMax = 127 / pOptions->ubDivide;
+	LONG lMin = -128 / pOptions->ubDivide;
+	for(ULONG i = 0; i < ulCount; ++i) {
+		LONG lScaled = (pSamples[i] * lTarget) / lPeak;
+		LONG lDivisor = 256 * pOptions->ubDivide;
+		LONG lValue = (lScaled + (lScaled < 0 ? -lDivisor / 2 : lDivisor / 2)) / lDivisor;
+		if(lValue > lMax) {
+			lValue = lMax;
+		}
+		else if(lValue < lMin) {
+			lValue = lMin;
+		}
+		pSfx->pData[i] = lValue;
+	}
+	free(pSamples);
+	return 1;
+}
+
+static void writeWordBe(FILE *pOut, UWORD uwValue) {
+	fputc(uwValue >> 8, pOut);
+	fputc(uwValue & 0xFF, pOut);
+}
+
+int main(int lArgCount, char *pArgs[]) {
+	tOptions sOptions = {.isNormalize = 0, .ubDivide = 1, .uwPad = 2, .ulRate = 0};
+	int lArg = 1;
+	for(; lArg < lArgCount && pArgs[lArg][0] == '-'; ++lArg) {
+		if(!strcmp(pArgs[lArg], "-normalize")) {
+			sOptions.isNormalize = 1;
+		}
+		else if(!strcmp(pArgs[lArg], "-divide") && lArg + 1 < lArgCount) {
+			sOptions.ubDivide = strtoul(pArgs[++lArg], 0, 10);
+		}
+		else if(!strcmp(pArgs[lArg], "-pad") && lArg + 1 < lArgCount) {
+			sOptions.uwPad = strtoul(pArgs[++lArg], 0, 10);
+		}
+		else if(!strcmp(pArgs[lArg], "-rate") && lArg + 1 < lArgCount) {
+			sOptions.ulRate = strtoul(pArgs[++lArg], 0, 10);
+		}
+		else {
+			break;
+		}
+	}
+	UWORD uwSfxCount = lArgCount - lArg - 1;
+	if(
+		lArg >= lArgCount || !uwSfxCount || uwSfxCount > SFX_BANK_SFX_MAX ||
+		!sOptions.ubDivide || !sOptions.uwPad || (sOptions.uwPad & 1)
+	) {
+		fprintf(
+			stderr,
+			"Usage: %s [-normalize] [-divide n] [-pad n] [-rate hz] out.bank in.wav...\n"
+			"Pad must be even, up to %d files\n", pArgs[0], SFX_BANK_SFX_MAX
+		);
+		return EXIT_FAILURE;
+	}
+
+	const char *szOutPath = pArgs[lArg++];
+	tSfx pSfxs[SFX_BANK_SFX_MAX];
+	UBYTE isOk = 1;
+	UWORD uwConverted = 0;
+	for(; isOk && uwConverted < uwSfxCount; ++uwConverted) {
+		isOk = convertSfx(pArgs[lArg + uwConverted], &sOptions, &pSfxs[uwConverted]);
+	}
+	if(!isOk) {
+		--uwConverted;
+	}
+
+	if(isOk) {
+		FILE *pOut = fopen(szOutPath, "wb");
+		if(!pOut) {
+			fprintf(stderr, "ERR: can't write '%s'\n", szOutPath);
+			isOk = 0;
+		}
+		else {
+			fputc(SFX_BANK_VERSION, pOut);
+			fputc(uwSfxCount, pOut);
+			fputc(sOptions.ubDivide, pOut);
+			for(UWORD i = 0; i < uwSfxCount; ++i) {
+				writeWordBe(pOut, pSfxs[i].ulLength / 2);
+			}
+			for(UWORD i = 0; i < uwSfxCount; ++i) {
+				fwrite(pSfxs[i].pData, 1, pSfxs[i].ulLength, pOut);
+			}
+			isOk = !ferror(pOut);
+			fclose(pOut);
+		}
+	}
+
+	for(UWORD i = 0; i < uwConverted; ++i) {
+		free(pSfxs[i].pData);
+	}
+	return isOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
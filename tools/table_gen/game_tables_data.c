@@ -0,0 +1,196 @@
+// Generated by tools/table_gen - don't edit.
+
+#include "game_tables.h"
+
+const ULONG g_pRowOffsetFromY[GAME_TABLES_ROW_COUNT] = {
+	0, 320, 640, 960, 1280, 1600, 1920, 2240, 2560, 2880, 3200, 3520, 3840, 4160, 4480, 4800,
+	5120, 5440, 5760, 6080, 6400, 6720, 7040, 7360, 7680, 8000, 8320, 8640, 8960, 9280, 9600, 9920,
+	10240, 10560, 10880, 11200, 11520, 11840, 12160, 12480, 12800, 13120, 13440, 13760, 14080, 14400, 14720, 15040,
+	15360, 15680, 16000, 16320, 16640, 16960, 17280, 17600, 17920, 18240, 18560, 18880, 19200, 19520, 19840, 20160,
+	20480, 20800, 21120, 21440, 21760, 22080, 22400, 22720, 23040, 23360, 23680, 24000, 24320, 24640, 24960, 25280,
+	25600, 25920, 26240, 26560, 26880, 27200, 27520, 27840, 28160, 28480, 28800, 29120, 29440, 29760, 30080, 30400,
+	30720, 31040, 31360, 31680, 32000, 32320, 32640, 32960, 33280, 33600, 33920, 34240, 34560, 34880, 35200, 35520,
+	35840, 36160, 36480, 36800, 37120, 37440, 37760, 38080, 38400, 38720, 39040, 39360, 39680, 40000, 40320, 40640,
+	40960, 41280, 41600, 41920, 42240, 42560, 42880, 43200, 43520, 43840, 44160, 44480, 44800, 45120, 45440, 45760,
+	46080, 46400, 46720, 47040, 47360, 47680, 48000, 48320, 48640, 48960, 49280, 49600, 49920, 50240, 50560, 50880,
+	51200, 51520, 51840, 52160, 52480, 52800, 53120, 53440, 53760, 54080, 54400, 54720, 55040, 55360, 55680, 56000,
+	56320, 56640, 56960, 57280, 57600, 57920, 58240, 58560, 58880, 59200, 59520, 59840, 60160, 60480, 60800, 61120,
+	61440, 61760, 62080, 62400, 62720, 63040, 63360, 63680, 64000, 64320, 64640, 64960, 65280, 65600, 65920, 66240,
+	66560, 66880, 67200, 67520, 67840, 68160, 68480, 68800, 69120, 69440, 69760, 70080, 70400, 70720, 71040, 71360,
+	71680, 72000, 72320, 72640, 72960, 73280, 73600, 73920, 74240, 74560, 74880, 75200, 75520, 75840, 76160, 76480,
+	76800, 77120, 77440, 77760, 78080, 78400, 78720, 79040, 79360, 79680, 80000, 80320, 80640, 80960, 81280, 81600,
+	81920, 82240, 82560, 82880, 83200, 83520, 83840, 84160, 84480, 84800, 85120, 85440, 85760, 86080, 86400, 86720,
+	87040, 87360, 87680, 88000, 88320, 88640, 88960, 89280, 89600, 89920, 90240, 90560, 90880, 91200, 91520, 91840,
+	92160, 92480, 92800, 93120, 93440, 93760, 94080, 94400, 94720, 95040, 95360, 95680, 96000, 96320, 96640, 96960,
+	97280, 97600, 97920, 98240, 98560, 98880, 99200, 99520, 99840, 100160, 100480, 100800, 101120, 101440, 101760, 102080,
+	102400, 102720, 103040, 103360, 103680, 104000, 104320, 104640, 104960, 105280, 105600, 105920, 106240, 106560, 106880, 107200,
+	107520, 107840, 108160, 108480, 108800, 109120, 109440, 109760, 110080, 110400, 110720, 111040, 111360, 111680, 112000, 112320,
+	112640, 112960, 113280, 113600, 113920, 114240, 114560, 114880, 115200, 115520, 115840, 116160, 116480, 116800, 117120, 117440,
+	117760, 118080, 118400, 118720, 119040, 119360, 119680, 120000, 120320, 120640, 120960, 121280, 121600, 121920, 122240, 122560,
+	122880, 123200, 123520, 123840, 124160, 124480, 124800, 125120, 125440, 125760, 126080, 126400, 126720, 127040, 127360, 127680,
+	128000, 128320, 128640, 128960, 129280, 129600, 129920, 130240, 130560, 130880, 131200, 131520, 131840, 132160, 132480, 132800,
+	133120, 133440, 133760, 134080, 134400, 134720, 135040, 135360, 135680, 136000, 136320, 136640, 136960, 137280, 137600, 137920,
+	138240, 138560, 138880, 139200, 139520, 139840, 140160, 140480, 140800, 141120, 141440, 141760, 142080, 142400, 142720, 143040,
+	143360, 143680, 144000, 144320, 144640, 144960, 145280, 145600, 145920, 146240, 146560, 146880, 147200, 147520, 147840, 148160,
+	148480, 148800, 149120, 149440, 149760, 150080, 150400, 150720, 151040, 151360, 151680, 152000, 152320, 152640, 152960, 153280,
+	153600, 153920, 154240, 154560, 154880, 155200, 155520, 155840, 156160, 156480, 156800, 157120, 157440, 157760, 158080, 158400,
+	158720, 159040, 159360, 159680, 160000, 160320, 160640, 160960, 161280, 161600, 161920, 162240, 162560, 162880, 163200, 163520,
+};
+
+const UWORD g_pRespawnSlotX[COLLISION_LOOKUP_SIZE_X][RESPAWN_SLOTS_PER_POSITION] = {
+	{16, 368, 0, 0},
+	{16, 368, 8, 8},
+	{16, 368, 16, 16},
+	{16, 368, 24, 24},
+	{16, 368, 32, 32},
+	{16, 368, 40, 40},
+	{16, 368, 48, 48},
+	{16, 368, 56, 56},
+	{16, 368, 64, 64},
+	{16, 368, 72, 72},
+	{16, 368, 80, 80},
+	{16, 368, 88, 88},
+	{16, 368, 96, 96},
+	{16, 368, 104, 104},
+	{16, 368, 112, 112},
+	{16, 368, 120, 120},
+	{16, 368, 128, 128},
+	{16, 368, 136, 136},
+	{16, 368, 144, 144},
+	{16, 368, 152, 152},
+	{16, 368, 160, 160},
+	{16, 368, 168, 168},
+	{16, 368, 176, 176},
+	{16, 368, 184, 184},
+	{16, 368, 192, 192},
+	{24, 376, 200, 200},
+	{32, 384, 208, 208},
+	{40, 392, 216, 216},
+	{48, 400, 224, 224},
+	{56, 408, 232, 232},
+	{64, 416, 240, 240},
+	{72, 424, 248, 248},
+	{80, 432, 256, 256},
+	{88, 440, 264, 264},
+	{96, 448, 272, 272},
+	{104, 456, 280, 280},
+	{112, 464, 288, 288},
+	{120, 472, 296, 296},
+	{128, 480, 304, 304},
+	{136, 488, 312, 312},
+	{144, 496, 320, 320},
+	{144, 496, 328, 328},
+	{144, 496, 336, 336},
+	{144, 496, 344, 344},
+	{144, 496, 352, 352},
+	{144, 496, 360, 360},
+	{144, 496, 368, 368},
+	{144, 496, 376, 376},
+	{144, 496, 384, 384},
+	{144, 496, 392, 392},
+	{144, 496, 400, 400},
+	{144, 496, 408, 408},
+	{144, 496, 416, 416},
+	{144, 496, 424, 424},
+	{144, 496, 432, 432},
+	{144, 496, 440, 440},
+	{144, 496, 448, 448},
+	{144, 496, 456, 456},
+	{144, 496, 464, 464},
+	{144, 496, 472, 472},
+	{144, 496, 480, 480},
+	{144, 496, 488, 488},
+	{144, 496, 496, 496},
+	{144, 496, 504, 504},
+};
+
+const UWORD g_pRespawnSlotY[COLLISION_LOOKUP_SIZE_Y][RESPAWN_SLOTS_PER_POSITION] = {
+	{0, 0, 24, 296},
+	{8, 8, 24, 296},
+	{16, 16, 24, 296},
+	{24, 24, 24, 296},
+	{32, 32, 24, 296},
+	{40, 40, 24, 296},
+	{48, 48, 24, 296},
+	{56, 56, 24, 296},
+	{64, 64, 24, 296},
+	{72, 72, 24, 296},
+	{80, 80, 24, 296},
+	{88, 88, 24, 296},
+	{96, 96, 24, 296},
+	{104, 104, 24, 296},
+	{112, 112, 24, 296},
+	{120, 120, 24, 296},
+	{128, 128, 24, 296},
+	{136, 136, 24, 296},
+	{144, 144, 24, 296},
+	{152, 152, 24, 304},
+	{160, 160, 24, 312},
+	{168, 168, 32, 320},
+	{176, 176, 40, 328},
+	{184, 184, 48, 336},
+	{192, 192, 56, 344},
+	{200, 200, 64, 352},
+	{208, 208, 72, 360},
+	{216, 216, 80, 368},
+	{224, 224, 88, 376},
+	{232, 232, 96, 384},
+	{240, 240, 104, 392},
+	{248, 248, 112, 400},
+	{256, 256, 120, 408},
+	{264, 264, 128, 416},
+	{272, 272, 136, 424},
+	{280, 280, 144, 432},
+	{288, 288, 152, 440},
+	{296, 296, 160, 448},
+	{304, 304, 168, 456},
+	{312, 312, 176, 464},
+	{320, 320, 184, 472},
+	{328, 328, 192, 480},
+	{336, 336, 200, 488},
+	{344, 344, 208, 488},
+	{352, 352, 216, 488},
+	{360, 360, 216, 488},
+	{368, 368, 216, 488},
+	{376, 376, 216, 488},
+	{384, 384, 216, 488},
+	{392, 392, 216, 488},
+	{400, 400, 216, 488},
+	{408, 408, 216, 488},
+	{416, 416, 216, 488},
+	{424, 424, 216, 488},
+	{432, 432, 216, 488},
+	{440, 440, 216, 488},
+	{448, 448, 216, 488},
+	{456, 456, 216, 488},
+	{464, 464, 216, 488},
+	{472, 472, 216, 488},
+	{480, 480, 216, 488},
+	{488, 488, 216, 488},
+	{496, 496, 216, 488},
+	{504, 504, 216, 488},
+};
+
+const BYTE g_pSpreadSide1[SPREAD_SIDE_COUNT] = {
+	-1, 0, 0, 0, -1, -1, 1, -1, 1, -1, -1, -1, -1, 0, 0, -1,
+	1, 1, 0, 1, 1, -1, 0, -1, 1, 1, 1, 0, 1, 1, 0, -1,
+	1, 0, 1, 1, -1, 1, -1, 0,
+};
+
+const BYTE g_pSpreadSide2[SPREAD_SIDE_COUNT] = {
+	1, -1, -2, -1, -1, 0, -1, 1, 0, -1, 1, -1, -2, 2, 2, -1,
+	-2, -2, 2, 1, 0, 0, 0, 2, -1, -2, -2, 0, 0, 2, -1, 2,
+	-2, -1, -1, -2, 2, 0, 2, 1,
+};
+
+const BYTE g_pSpreadSide3[SPREAD_SIDE_COUNT] = {
+	-2, 0, 0, 2, 3, -2, 2, -3, 1, 3, 3, -3, -1, 0, 0, 3,
+	0, 0, 1, 1, 2, -1, -2, -3, -2, 3, 3, -1, -1, 3, -3, 2,
+	1, -3, 2, -2, 3, 2, 1, 1,
+};
+
+const BYTE g_pSpreadSide10[SPREAD_SIDE_COUNT] = {
+	1, 3, -1, -5, 7, -4, -6, 3, -6, 6, -9, -1, 1, 3, -8, 2,
+	-6, -2, -9, -3, -4, 0, 6, 9, 2, -5, -4, -9, 7, 10, -4, -9,
+	-10, 8, 7, -10, -7, 10, 9, -3,
+};
@@ -0,0 +1,180 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Host-side generator of game's lookup tables. Writes C sources with const
+// arrays declared in src/game_tables.h, using same formulas as the game's
+// runtime fallback in src/game_tables.c. Data tables don't need libfixmath,
+// math ones are only written when built with it & GAME_TABLES_HOST_MATH.
+// Usage: table_gen data.c [math.c]
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+// ACE types & macros needed by game_tables_calc.h
+typedef uint8_t UBYTE;
+typedef int8_t BYTE;
+typedef uint16_t UWORD;
+typedef int16_t WORD;
+typedef uint32_t ULONG;
+typedef int32_t LONG;
+#define CLAMP(x, min, max) ((x) < (min) ? (min) : ((x) > (max) ? (max) : (x)))
+
+#include "game_tables_calc.h"
+
+#define VALUES_PER_LINE 16
+
+static void writeSeparator(
+	FILE *pOut, ULONG ulIndex, ULONG ulCount, const char *szIndent
+) {
+	if(ulIndex + 1 == ulCount) {
+		fprintf(pOut, ",\n");
+	}
+	else if((ulIndex + 1) % VALUES_PER_LINE == 0) {
+		fprintf(pOut, ",\n%s", szIndent);
+	}
+	else {
+		fprintf(pOut, ", ");
+	}
+}
+
+#if defined(GAME_TABLES_HOST_MATH)
+static void writeAtanOctant(FILE *pOut) {
+	fprintf(
+		pOut, "const UBYTE g_pAtanOctant[GAME_MATH_ATAN_RATIO_COUNT + 1] = {\n\t"
+	);
+	for(UWORD uwRatio = 0; uwRatio <= GAME_MATH_ATAN_RATIO_COUNT; ++uwRatio) {
+		fprintf(pOut, "%" PRIu8, gameTablesCalcAtanOctant(uwRatio));
+		writeSeparator(pOut, uwRatio, GAME_MATH_ATAN_RATIO_COUNT + 1, "\t");
+	}
+	fprintf(pOut, "};\n\n");
+}
+
+static void writeSin(FILE *pOut) {
+	fprintf(pOut, "const fix16_t g_pSin[GAME_MATH_ANGLE_COUNT] = {\n\t");
+	for(UWORD uwAngle = 0; uwAngle < GAME_MATH_ANGLE_COUNT; ++uwAngle) {
+		fprintf(pOut, "%" PRId32, gameTablesCalcSin(uwAngle));
+		writeSeparator(pOut, uwAngle, GAME_MATH_ANGLE_COUNT, "\t");
+	}
+	fprintf(pOut, "};\n\n");
+
+	fprintf(pOut, "const tFix10p6 g_pSin10p6[GAME_MATH_ANGLE_COUNT] = {\n\t");
+	for(UWORD uwAngle = 0; uwAngle < GAME_MATH_ANGLE_COUNT; ++uwAngle) {
+		fprintf(pOut, "%" PRId16, gameTablesCalcSin10p6(uwAngle));
+		writeSeparator(pOut, uwAngle, GAME_MATH_ANGLE_COUNT, "\t");
+	}
+	fprintf(pOut, "};\n");
+}
+#endif
+
+static void writeRowOffsets(FILE *pOut) {
+	fprintf(pOut, "const ULONG g_pRowOffsetFromY[GAME_TABLES_ROW_COUNT] = {\n\t");
+	for(UWORD uwY = 0; uwY < GAME_TABLES_ROW_COUNT; ++uwY) {
+		fprintf(pOut, "%" PRIu32, gameTablesCalcRowOffset(uwY));
+		writeSeparator(pOut, uwY, GAME_TABLES_ROW_COUNT, "\t");
+	}
+	fprintf(pOut, "};\n\n");
+}
+
+static void writeRespawnSlots(
+	FILE *pOut, const char *szAxis, UWORD uwLookupCount,
+	UWORD (*cbCalc)(UWORD uwLookup, UBYTE ubSlot)
+) {
+	fprintf(
+		pOut,
+		"const UWORD g_pRespawnSlot%s[COLLISION_LOOKUP_SIZE_%s]"
+		"[RESPAWN_SLOTS_PER_POSITION] = {\n", szAxis, szAxis
+	);
+	for(UWORD uwLookup = 0; uwLookup < uwLookupCount; ++uwLookup) {
+		fprintf(pOut, "\t{");
+		for(UBYTE ubSlot = 0; ubSlot < RESPAWN_SLOTS_PER_POSITION; ++ubSlot) {
+			fprintf(
+				pOut, "%s%" PRIu16, ubSlot ? ", " : "", cbCalc(uwLookup, ubSlot)
+			);
+		}
+		fprintf(pOut, "},\n");
+	}
+	fprintf(pOut, "};\n\n");
+}
+
+static void writeSpreadSides(FILE *pOut) {
+	BYTE pSides[4][SPREAD_SIDE_COUNT];
+	static const char *pNames[] = {"1", "2", "3", "10"};
+	gameTablesCalcSpreadSides(pSides[0], pSides[1], pSides[2], pSides[3]);
+	for(UBYTE ubTable = 0; ubTable < 4; ++ubTable) {
+		fprintf(
+			pOut, "const BYTE g_pSpreadSide%s[SPREAD_SIDE_COUNT] = {\n\t",
+			pNames[ubTable]
+		);
+		for(UBYTE i = 0; i < SPREAD_SIDE_COUNT; ++i) {
+			fprintf(pOut, "%" PRId8, pSides[ubTable][i]);
+			writeSeparator(pOut, i, SPREAD_SIDE_COUNT, "\t");
+		}
+		fprintf(pOut, "};\n%s", ubTable + 1 < 4 ? "\n" : "");
+	}
+}
+
+static FILE *openOutput(const char *szPath) {
+	FILE *pOut = fopen(szPath, "w");
+	if(!pOut) {
+		fprintf(stderr, "Can't open %s for writing\n", szPath);
+		return 0;
+	}
+	fprintf(pOut, "// Generated by tools/table_gen - don't edit.\n\n");
+	fprintf(pOut, "#include \"game_tables.h\"\n\n");
+	return pOut;
+}
+
+static int closeOutput(FILE *pOut, const char *szPath) {
+	if(fclose(pOut)) {
+		fprintf(stderr, "Can't write %s\n", szPath);
+		return 0;
+	}
+	return 1;
+}
+
+int main(int lArgCount, char *pArgs[]) {
+#if defined(GAME_TABLES_HOST_MATH)
+	if(lArgCount != 2 && lArgCount != 3) {
+		fprintf(stderr, "Usage: %s data.c [math.c]\n", pArgs[0]);
+		return 1;
+	}
+#else
+	if(lArgCount != 2) {
+		fprintf(stderr, "Usage: %s data.c (built without libfixmath)\n", pArgs[0]);
+		return 1;
+	}
+#endif
+
+	FILE *pOut = openOutput(pArgs[1]);
+	if(!pOut) {
+		return 1;
+	}
+	writeRowOffsets(pOut);
+	writeRespawnSlots(
+		pOut, "X", COLLISION_LOOKUP_SIZE_X, gameTablesCalcRespawnSlotX
+	);
+	writeRespawnSlots(
+		pOut, "Y", COLLISION_LOOKUP_SIZE_Y, gameTablesCalcRespawnSlotY
+	);
+	writeSpreadSides(pOut);
+	if(!closeOutput(pOut, pArgs[1])) {
+		return 1;
+	}
+
+#if defined(GAME_TABLES_HOST_MATH)
+	if(lArgCount == 3) {
+		pOut = openOutput(pArgs[2]);
+		if(!pOut) {
+			return 1;
+		}
+		writeAtanOctant(pOut);
+		writeSin(pOut);
+		if(!closeOutput(pOut, pArgs[2])) {
+			return 1;
+		}
+	}
+#endif
+	return 0;
+}